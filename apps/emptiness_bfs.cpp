@@ -1,7 +1,9 @@
 #include "include/emptiness_cmd_helper.hpp"
 #include "utils/converters.hpp"
+#include "utils/reduce.hpp"
 
 #include "bfs/emerson.hpp"
+#include "scc_parallel/coloring.hpp"
 
 /// \brief Author info
 constexpr static const char* AUTHOR_TEXT = "\
@@ -10,7 +12,31 @@ NOT ME =)\n\
 
 /// \brief Program calculation mode description
 constexpr static const char* INFO_TEXT = "\
-TODO: Add desription\n\
+Emptiness check: Algorithms based on breadth-first (set-based) search \n\
+\n\
+Emerson-Lei nested fixpoint: states that cannot reach every final set through a cycle are repeatedly pruned\n\
+with the backward searches over the inverse transition table. Works for both automatone types (NBA/NGA)\n\
+Every level of the backward searches is expanded by the pool of the worker threads\n\
+\n\
+Parallel SCC decomposition (trimming + coloring): looks for the non-trivial SCC that intersects every final set.\n\
+Works for both automatone types (NBA/NGA) on the same worker threads\n\
+ NBA -- nondeterministic Büchi automaton;\n\
+ NGA -- nondeterministic Generalized Büchi automaton;\n\
+\n\
+'THIS_BINARY' usage:\n\
+\n\
+--generator         [number > 0]    enable generation mode. See more info by calling it with help parameter;\n\
+--help              [NONE/bool]     Show info about this binary (programm);\n\
+--nba               [NONE/bool]     Works only with NBA (converts NGA if needed);\n\
+--trim              [NONE/bool]     Drops unreachable, dead end and not reaching final sets states before checks;\n\
+--reduce            [NONE/bool]     Merges bisimilar states before conversion and checks (after --trim).\
+                                        In generation mode the trim and the reduction are timed as one phase;\n\
+--in_file           [text]          Input file name where we store interested automaton;\n\
+--out_file          [text]          Output file name where we will dump converted automaton (if will exist);\n\
+--threads           [number]        Number of the worker threads. Default (0) takes all hardware threads.\
+                                        In generation mode the serial check is compared with this one;\n\
+************************\n\
+Return true or false for selected algorithm\n\
 \n";
 
 /// \brief Handle default usage case: calculation of the input automaton
@@ -18,46 +44,94 @@ TODO: Add desription\n\
 void handle_user_case_call(const emptiness_cmd_helper::options& opts) noexcept
 {
     using namespace emptiness_cmd_helper;
-    auto automaton = proceed_data(opts.in_file);
-    // need to convert in case of Nested algorithm for NGA
-    auto nba_automaton = (opts.nba || opts.non_optimal_only) ?
-                         std::move(proceed_conversion(automaton, opts.out_file)) :
-                         std::nullopt;
+    // state type is selected by the biggest read state (and by the NBA states if the conversion is requested)
+    auto fitted = proceed_data<utils::representation::fitted_buchi>(opts.in_file, opts.nba);
 
-    // Return reference on the work automaton (to prevent redundant copying)
-    auto get_worker = [&automaton, &nba_automaton]
-        { return automates::inv_buchi(std::move(nba_automaton ? *nba_automaton : automaton)); };
+    std::visit([&opts](auto &read)
+    {
+        using State = typename std::decay_t<decltype(read)>::atm_size;
+        // trimmed copy replaces the read automaton
+        auto trimmed = proceed_trim(read, opts);
+        if (trimmed && !trimmed->automaton)
+        {
+            std::cout << std::boolalpha << "...\nTrim: " << true << "\n";
+            return;
+        }
+        auto& trimmed_automaton = trimmed ? *trimmed->automaton : read;
+        auto quotient = proceed_reduction(trimmed_automaton, opts);
+        auto& automaton = quotient ? *quotient : trimmed_automaton;
+        // conversion only on demand: NGA is supported natively
+        auto nba_automaton = opts.nba ?
+                             std::move(proceed_conversion(automaton, opts.out_file)) :
+                             std::nullopt;
 
-    using namespace emptiness_check::bfs;
-    std::cout << std::boolalpha << "...\n";
-    // TODO: finish it @Karlion!
-    if (opts.non_optimal_only)
-        std::cout << "Emerson: " << emerson::is_empty(get_worker()) << "\n";
-    else
-        std::cout << "Non-optimal Emerson: " << emerson::is_empty(get_worker()) << "\n";
+        // Return reference on the work automaton (to prevent redundant copying)
+        auto get_worker = [&automaton, &nba_automaton]
+            { return automates::basic_inv_buchi<State>(std::move(nba_automaton ? *nba_automaton : automaton)); };
+
+        using namespace emptiness_check::bfs;
+        std::cout << std::boolalpha << "...\n";
+        const auto worker = get_worker();
+        const char* type = worker.is_generalized() ? "NGA" : "NBA";
+        emerson::edges_report edges;
+        std::cout << "Emerson-Lei (" << type << "): " << emerson::is_empty(worker, nullptr, opts.threads, &edges) <<
+                  "\n";
+        std::cout << "Emerson-Lei inspected edges: " << edges.inspected << " (plain top-down: " << edges.top_down <<
+                  ")\n";
+        std::cout << "Parallel SCC (" << type << "): " <<
+                  emptiness_check::scc_parallel::is_empty(worker, nullptr, opts.threads) << "\n";
+    }, fitted);
 }
 
 /// \brief Initialize callbacks for generation
+/// \param Automaton: generated automaton type (with the inverse transition table)
 /// \param opts: generation options that will be passed for appropriate callback
+/// \param cmd_opts: command line options (number of the worker threads)
 /// \return callbacks handler object
-inline emptiness_check::statistic::callbacks_handler<automates::inv_buchi> intialize_callbacks(
-        const utils::generator::generator_opts &opts) noexcept
+template<typename Automaton>
+emptiness_check::statistic::callbacks_handler<Automaton> intialize_callbacks(
+        const utils::generator::generator_opts &opts, const emptiness_cmd_helper::options &cmd_opts) noexcept
 {
+    using inv_buchi = Automaton;
+    using buchi = automates::basic_buchi<typename Automaton::atm_size>;
+    auto serial = [](const inv_buchi &at, std::size_t *peak)
+        { return emptiness_check::bfs::emerson::is_empty(at, peak, 1); };
+    auto parallel = [threads = cmd_opts.threads](const inv_buchi &at, std::size_t *peak)
+        { return emptiness_check::bfs::emerson::is_empty(at, peak, threads); };
+    auto scc = [threads = cmd_opts.threads](const inv_buchi &at, std::size_t *peak)
+        { return emptiness_check::scc_parallel::is_empty(at, peak, threads); };
+
     return {
-            .generation_fn = [&opts]() { return automates::inv_buchi(utils::generator::generate_automaton(opts)); },
-            .conv_fn = [](const automates::inv_buchi& at) -> std::optional<automates::inv_buchi>
+            .generation_fn = [&opts]()
+            { return inv_buchi(utils::generator::generate_automaton<typename Automaton::atm_size>(opts)); },
+            .reduce_fn = !cmd_opts.reduce && !cmd_opts.trim ? nullptr :
+                         std::function([threads = cmd_opts.threads, trim = cmd_opts.trim, reduce = cmd_opts.reduce]
+                                       (const inv_buchi &at) -> std::optional<inv_buchi>
+                         {
+                             /// \note the empty trimmed automaton can't be represented: the generated one is kept
+                             auto trimmed = trim ? utils::reduce::trim(at).automaton : std::nullopt;
+                             if (!reduce)
+                                 return trimmed ? std::make_optional(inv_buchi(std::move(*trimmed))) : std::nullopt;
+
+                             /// \note Yes, slicing
+                             const buchi &source = trimmed ? *trimmed : static_cast<const buchi&>(at);
+                             return inv_buchi(emptiness_check::reduce::quotient(source, threads));
+                         }),
+            .conv_fn = [](const inv_buchi& at) -> std::optional<inv_buchi>
             {
                 /// \note Yes, slicing
-                auto nba = utils::converters::nga2nba(static_cast<automates::buchi>(at));
+                auto nba = utils::converters::nga2nba(static_cast<const buchi&>(at));
                 return nba ?
-                    std::make_optional(automates::inv_buchi(std::move(*nba))) :
+                    std::make_optional(inv_buchi(std::move(*nba))) :
                     std::nullopt;
             },
-            .nba_algorithms = {
-                    &emptiness_check::bfs::emerson::is_empty,
-            },
-            .nga_algorithms = {
-                    &emptiness_check::bfs::emerson::is_empty
+            .nba_algorithms = { serial, parallel, scc },
+            .nga_algorithms = { serial, parallel, scc },
+            .edges_fn = [](const inv_buchi &at)
+            {
+                emptiness_check::bfs::emerson::edges_report edges;
+                emptiness_check::bfs::emerson::is_empty(at, nullptr, 1, &edges);
+                return std::make_pair(edges.inspected, edges.top_down);
             }
     };
 }
@@ -69,7 +143,10 @@ int main(int argc, const char *argv[])
 {
     emptiness_cmd_helper::command_line<automates::inv_buchi>(argc, argv,
                         { AUTHOR_TEXT, INFO_TEXT,
-                          {"NBA EMERSON", "NGA EMERSON" },
-                          &handle_user_case_call, &intialize_callbacks });
+                          {"NBA EMERSON", "NBA EMERSON PAR.", "NBA SCC PAR.",
+                           "NGA EMERSON", "NGA EMERSON PAR.", "NGA SCC PAR." },
+                          &handle_user_case_call, &intialize_callbacks<automates::inv_buchi>,
+                          &intialize_callbacks<emptiness_cmd_helper::widest_t<automates::inv_buchi>>,
+                          { {0, 1}, {3, 4} } });
     return 0;
 }
@@ -5,7 +5,13 @@
 #include "include/emptiness_cmd_helper.hpp"
 
 #include "dfs/nested.hpp"
+#include "dfs/cndfs.hpp"
 #include "dfs/two_stack.hpp"
+#include "dfs/couvreur.hpp"
+#include "dfs/tarjan.hpp"
+#include "batch.hpp"
+
+#include <filesystem>
 
 /// \brief Author info
 constexpr static const char* AUTHOR_TEXT = "\
@@ -20,8 +26,10 @@ constexpr static const char* INFO_TEXT = "\
 Emptiness check: Algorithms based on depth-first search \n\
 \n\
 We present two emptiness algorithms that explore A using depth-first search (DFS):\n\
-    1. Nested -- used by NBA only\n\
+    1. Nested -- used by NBA only (also as the swarm or the cooperating (CNDFS) parallel workers)\n\
     2. Two-stacked - used by default for both automatone types (NBA/NGA)\n\
+    3. Couvreur -- SCC-based, also for both automatone types (merges final sets per SCC, no degeneralization)\n\
+    4. Tarjan -- full SCC decomposition with the acceptance summary of every SCC\n\
  NBA -- nondeterministic Büchi automaton;\n\
  NGA -- nondeterministic Generalized Büchi automaton;\n\
 This program also provide NGA-to-NBA converter. For greater compatibility.\n\
@@ -34,52 +42,305 @@ The AIM of the program is to answer if A is nonempty and if it has an accepting
 --help              [NONE/bool]     Show info about this binary (programm);\n\
 --nba               [NONE/bool]     Works only with NBA (converts NGA if needed);\n\
 --non_optimal_only  [NONE/bool]     Invokes Nested algorithm. We use Two-stack by default (because optimal);\n\
+--packed            [NONE/bool]     Nested algorithm keeps visiting info in the packed bit array (3 bits per state);\n\
+--swarm             [NONE/bool]     Nested algorithm runs independent workers with the random successors orders.\
+                                        The first one that finds the lasso stops the others;\n\
+--cndfs             [NONE/bool]     Nested algorithm runs workers that share the red/blue colors (CNDFS);\n\
+--couvreur          [NONE/bool]     Invokes Couvreur algorithm instead of Two-stack;\n\
+--tarjan            [NONE/bool]     Prints the SCCs table summary (Tarjan): SCCs with final states, their sizes;\n\
+--trim              [NONE/bool]     Drops unreachable, dead end and not reaching final sets states before checks;\n\
+--reduce            [NONE/bool]     Merges bisimilar states before conversion and checks (after --trim).\
+                                        In generation mode the trim and the reduction are timed as one phase;\n\
+--lasso             [NONE/bool]     Prints the accepting lasso (stem and cycle) found by Nested/Two-stack algorithm.\
+                                        Not combined with --packed, --swarm, --cndfs, --couvreur, --tarjan.\
+                                        States are numbered as in the checked (reduced or converted) automaton;\n\
+--lasso_file        [text]          Output file name where we will dump the lasso (enables --lasso);\n\
+--batch             [text]          Directory or list file (one path per line) of the automata checked at once\
+                                        by Two-stack (or Nested/Couvreur/Tarjan, --nba and --packed apply).\
+                                        Next files are read during the checks;\n\
+--threads           [number]        Number of the swarm/CNDFS workers. Default (0) takes all hardware threads;\n\
 --in_file           [text]          Input file name where we store interested automaton;\n\
 --out_file          [text]          Output file name where we will dump converted automaton (if will exist);\n\
 ************************\n\
 Return true or false for selected algorithm\n\
 \n";
 
+/// \brief Print the SCCs table summary: numbers of the SCCs and the non-trivial SCCs that meet final sets
+/// \param State: state type of the automaton
+/// \param table: decomposed automaton
+template<typename State>
+void print_scc_table(const emptiness_check::dfs::tarjan::scc_table<State> &table) noexcept
+{
+    std::size_t non_trivial = 0;
+    for (std::size_t c = 0; c < table.components_num(); ++c)
+        non_trivial += !table.is_trivial(c);
+    std::cout << "SCCs: " << table.components_num() << " (non-trivial " << non_trivial << ")\n";
+
+    for (std::size_t c = 0; c < table.components_num(); ++c)
+        if (!table.is_trivial(c) && automates::mask::any(table.marks(c)))
+            std::cout << "\tSCC " << c << ": " << table.size(c) << " states, " <<
+                      automates::mask::count(table.marks(c)) << " final sets\n";
+}
+
+/// \brief Print the lasso and dump it if needed
+/// \param State: state type of the automaton
+/// \param found: lasso of the nonempty automaton or nullopt
+/// \param name: output file name. Dumping will be ignored on empty name or incorrect file
+template<typename State>
+void proceed_lasso(const std::optional<emptiness_check::dfs::lasso<State>> &found, const std::string &name) noexcept
+{
+    if (!found)
+    {
+        std::cout << "No lasso: automaton is empty\n";
+        return;
+    }
+
+    auto write = [&found](std::ostream &out)
+    {
+        out << "Stem:";
+        for (const auto s : found->stem)
+            out << " " << s;
+        out << "\nCycle:";
+        for (const auto s : found->cycle)
+            out << " " << s;
+        out << "\n";
+    };
+    write(std::cout);
+
+    if (!name.empty())
+    {
+        std::ofstream fs(name, std::fstream::out);
+        if (!fs.is_open())
+            std::cerr << "Failed to dump to " << name << " file!\n";
+        else
+        {
+            write(fs);
+            std::cout << "Successfully dumped lasso into the " << name << " file\n";
+        }
+    }
+}
+
+/// \brief Check all automata of the directory or the list file at once
+/// \param opts: parsed command line options
+void handle_batch_case_call(const emptiness_cmd_helper::options& opts) noexcept
+{
+    if (opts.swarm || opts.cndfs || opts.lasso || !opts.lasso_file.empty() || opts.trim || opts.reduce)
+    {
+        std::cerr << "Batch mode does not support --swarm, --cndfs, --lasso, --lasso_file, --trim and --reduce "
+                     "options\n";
+        return;
+    }
+
+    namespace fs = std::filesystem;
+    std::vector<std::string> paths;
+    if (std::error_code ec; fs::is_directory(opts.batch, ec))
+    {
+        for (const auto& entry : fs::directory_iterator(opts.batch, ec))
+            if (entry.is_regular_file(ec))
+                paths.push_back(entry.path().string());
+        std::sort(paths.begin(), paths.end());
+    }
+    else
+    {
+        std::ifstream list(opts.batch, std::fstream::in);
+        if (!list.is_open())
+        {
+            std::cerr << "Failed to read from " << opts.batch << " file!\n";
+            return;
+        }
+        for (std::string line; std::getline(list, line);)
+            if (!line.empty())
+                paths.push_back(line);
+    }
+
+    using automaton = utils::representation::fitted_frozen_buchi;
+    using namespace emptiness_check::dfs;
+    // the same algorithm selection as for the single automaton
+    const bool nba = opts.nba || opts.non_optimal_only;
+    const emptiness_check::batch::check_fn<automaton> fn =
+        [&opts, nba](const automaton &at, std::pmr::memory_resource *scratch, std::size_t *peak)
+    {
+        return std::visit([&opts, nba, scratch, peak](const auto &read)
+        {
+            // need to convert in case of Nested algorithm for NGA: every worker converts its own automata
+            const auto converted = nba ? utils::converters::nga2nba(read) : std::nullopt;
+            const auto &worker = converted ? *converted : read;
+
+            if (opts.non_optimal_only)
+                return opts.packed ? nested::is_empty_packed(worker, peak) : nested::is_empty(worker, peak);
+            if (opts.tarjan)
+                return tarjan::is_empty(worker, peak);
+            if (opts.couvreur)
+                return couvreur::is_empty(worker, peak);
+            return two_stack::is_empty(worker, peak, scratch);
+        }, at);
+    };
+
+    const auto report = emptiness_check::batch::check(paths, fn, opts.threads, 0, nba);
+
+    std::size_t empty = 0, unread = 0;
+    std::cout << std::boolalpha << "...\n";
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        const auto& result = report.results[i];
+        std::cout << paths[i] << ": ";
+        if (result)
+            std::cout << *result << "\n";
+        else
+            std::cout << "failed to read\n";
+        empty += result.value_or(false);
+        unread += !result;
+    }
+    std::cout << "Batch: " << paths.size() << " automata, " << empty << " empty, " << unread << " unread\n";
+    for (std::size_t w = 0; w < report.checks.size(); ++w)
+        std::cout << "\tWorker " << w << ": " << report.checks[w] << " checks, peak scratch " <<
+                  emptiness_cmd_helper::bytes2string(report.scratch_peak[w]) << "\n";
+}
+
 /// \brief Handle default usage case: calculation of the input automaton
 /// \param opts: parsed command line options
 void handle_user_case_call(const emptiness_cmd_helper::options& opts) noexcept
 {
     using namespace emptiness_cmd_helper;
-    auto automaton = proceed_data(opts.in_file);
-    // need to convert in case of Nested algorithm for NGA
-    auto nba_automaton = (opts.nba || opts.non_optimal_only) ?
-                          std::move(proceed_conversion(automaton, opts.out_file)) :
-                          std::nullopt;
+    if (!opts.batch.empty())
+        return handle_batch_case_call(opts);
 
-    // Return reference on the work automaton (to prevent redundant copying)
-    auto get_worker = [&automaton, &nba_automaton]() -> const auto&
-                      { return nba_automaton ? *nba_automaton : automaton; };
+    const bool lasso = opts.lasso || !opts.lasso_file.empty();
+    // the lasso is taken from the Nested or Two-stack search itself
+    if (lasso && (opts.packed || opts.swarm || opts.cndfs || opts.couvreur || opts.tarjan))
+    {
+        std::cerr << "Lasso is found by Nested/Two-stack algorithm only: remove --packed, --swarm, --cndfs, "
+                     "--couvreur and --tarjan options\n";
+        return;
+    }
 
+    // state type is selected by the biggest read state (and by the NBA states if the conversion is requested)
+    auto fitted = proceed_data<utils::representation::fitted_frozen_buchi>(opts.in_file,
+                                                                          opts.nba || opts.non_optimal_only);
 
-    using namespace emptiness_check::dfs;
-    std::cout << std::boolalpha << "...\n";
-    if (opts.non_optimal_only)
-        std::cout << "Nested: " << nested::is_empty(get_worker()) << "\n";
-    else
-        std::cout << "Two-stack (" << (get_worker().is_generalized() ? "NGA" : "NBA") << "): " <<
-                  two_stack::is_empty(get_worker()) << "\n";
+    std::visit([&opts, lasso](const auto &read)
+    {
+        // trimmed copy replaces the read automaton
+        const auto trimmed = proceed_trim(read, opts);
+        if (trimmed && !trimmed->automaton)
+        {
+            std::cout << std::boolalpha << "...\nTrim: " << true << "\n";
+            if (lasso)
+                proceed_lasso<typename std::decay_t<decltype(read)>::atm_size>(std::nullopt, opts.lasso_file);
+            return;
+        }
+        const auto &trimmed_automaton = trimmed ? *trimmed->automaton : read;
+
+        auto reduced = proceed_reduction(trimmed_automaton, opts);
+        const auto &automaton = reduced ? *reduced : trimmed_automaton;
+
+        // need to convert in case of Nested algorithm for NGA
+        auto nba_automaton = (opts.nba || opts.non_optimal_only) ?
+                             std::move(proceed_conversion(automaton, opts.out_file)) :
+                             std::nullopt;
+
+        // Return reference on the work automaton (to prevent redundant copying)
+        auto get_worker = [&automaton, &nba_automaton]() -> const auto&
+                          { return nba_automaton ? *nba_automaton : automaton; };
+
+        using namespace emptiness_check::dfs;
+        std::cout << std::boolalpha << "...\n";
+        if (lasso)
+        {
+            // one search answers and finds the lasso
+            const auto found = opts.non_optimal_only ? nested::find_lasso(get_worker()) :
+                                                       two_stack::find_lasso(get_worker());
+            if (opts.non_optimal_only)
+                std::cout << "Nested: " << !found << "\n";
+            else
+                std::cout << "Two-stack (" << (get_worker().is_generalized() ? "NGA" : "NBA") << "): " <<
+                          !found << "\n";
+            if (reduced || nba_automaton)
+                std::cout << "Lasso states are numbered as in the " << (reduced ? "reduced" : "") <<
+                          (reduced && nba_automaton ? " and " : "") << (nba_automaton ? "converted NBA" : "") <<
+                          " automaton\n";
+            proceed_lasso(found, opts.lasso_file);
+        }
+        else if (opts.non_optimal_only && opts.cndfs)
+            std::cout << "CNDFS: " << cndfs::is_empty(get_worker(), nullptr, opts.threads) << "\n";
+        else if (opts.non_optimal_only && opts.swarm)
+            std::cout << "Nested (swarm): " << nested::is_empty_swarm(get_worker(), nullptr, opts.threads) << "\n";
+        else if (opts.non_optimal_only)
+            std::cout << "Nested" << (opts.packed ? " (packed)" : "") << ": " <<
+                      (opts.packed ? nested::is_empty_packed(get_worker()) : nested::is_empty(get_worker())) << "\n";
+        else if (opts.tarjan)
+        {
+            const tarjan::scc_table table(get_worker());
+            std::cout << "Tarjan (" << (get_worker().is_generalized() ? "NGA" : "NBA") << "): " <<
+                      table.is_empty() << "\n";
+            print_scc_table(table);
+        }
+        else if (opts.couvreur)
+            std::cout << "Couvreur (" << (get_worker().is_generalized() ? "NGA" : "NBA") << "): " <<
+                      couvreur::is_empty(get_worker()) << "\n";
+        else
+            std::cout << "Two-stack (" << (get_worker().is_generalized() ? "NGA" : "NBA") << "): " <<
+                      two_stack::is_empty(get_worker()) << "\n";
+    }, fitted);
 }
 
 /// \brief Initialize callbacks for generation
+/// \param Automaton: generated automaton type (frozen)
 /// \param opts: generation options that will be passed for appropriate callback
+/// \param cmd_opts: command line options (number of the swarm/CNDFS workers)
 /// \return callbacks handler object
-inline emptiness_check::statistic::callbacks_handler<automates::buchi> intialize_callbacks(
-        const utils::generator::generator_opts &opts) noexcept
+template<typename Automaton>
+emptiness_check::statistic::callbacks_handler<Automaton> intialize_callbacks(
+        const utils::generator::generator_opts &opts, const emptiness_cmd_helper::options &cmd_opts) noexcept
 {
+    using frozen_buchi = Automaton;
     return {
-        .generation_fn = [&opts] { return utils::generator::generate_automaton(opts); },
-        .conv_fn = &utils::converters::nga2nba,
+        .generation_fn = [&opts]
+        { return utils::generator::generate_frozen_automaton<typename Automaton::atm_size>(opts); },
+        .reduce_fn = !cmd_opts.reduce && !cmd_opts.trim ? nullptr :
+                     std::function([threads = cmd_opts.threads, trim = cmd_opts.trim, reduce = cmd_opts.reduce]
+                                   (const frozen_buchi &at) -> std::optional<frozen_buchi>
+                     {
+                         /// \note the empty trimmed automaton can't be represented: the generated one is kept
+                         auto trimmed = trim ? utils::reduce::trim(at).automaton : std::nullopt;
+                         if (!reduce)
+                             return trimmed;
+
+                         return emptiness_check::reduce::quotient(trimmed ? *trimmed : at, threads);
+                     }),
+        .conv_fn = [](const frozen_buchi &at) { return utils::converters::nga2nba(at); },
         .nba_algorithms = {
-                &emptiness_check::dfs::nested::is_empty,
-                &emptiness_check::dfs::two_stack::is_empty
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::nested::is_empty(at, scratch); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::nested::is_empty_packed(at, scratch); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::two_stack::is_empty(at, scratch); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::two_stack::is_empty_recursive(at, scratch); },
+                [threads = cmd_opts.threads](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::nested::is_empty_swarm(at, scratch, threads); },
+                // CNDFS scaling across the thread counts
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::cndfs::is_empty(at, scratch, 1); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::cndfs::is_empty(at, scratch, 2); },
+                [threads = cmd_opts.threads](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::cndfs::is_empty(at, scratch, threads); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::couvreur::is_empty(at, scratch); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::tarjan::is_empty(at, scratch); }
         },
         .nga_algorithms = {
-                &emptiness_check::dfs::two_stack::is_empty
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::two_stack::is_empty(at, scratch); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::two_stack::is_empty_recursive(at, scratch); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::couvreur::is_empty(at, scratch); },
+                [](const frozen_buchi &at, std::size_t *scratch)
+                { return emptiness_check::dfs::tarjan::is_empty(at, scratch); }
         }
     };
 }
@@ -89,9 +350,13 @@ inline emptiness_check::statistic::callbacks_handler<automates::buchi> intialize
 /// \param argv: list of command-line arguments
 int main(int argc, const char *argv[])
 {
-    emptiness_cmd_helper::command_line<automates::buchi>(argc, argv,
+    emptiness_cmd_helper::command_line<automates::frozen_buchi>(argc, argv,
                         { AUTHOR_TEXT, INFO_TEXT,
-                          { "NESTED", "TWO-STACK NBA", "TWO-STACK NGA" },
-                          &handle_user_case_call, &intialize_callbacks });
+                          { "NESTED", "NESTED PACKED", "TWO-STACK NBA", "TWO-STACK REC. NBA", "NESTED SWARM",
+                            "CNDFS 1T", "CNDFS 2T", "CNDFS", "COUVREUR NBA",
+                            "TARJAN NBA", "TWO-STACK NGA", "TWO-STACK REC. NGA", "COUVREUR NGA", "TARJAN NGA" },
+                          &handle_user_case_call, &intialize_callbacks<automates::frozen_buchi>,
+                          &intialize_callbacks<emptiness_cmd_helper::widest_t<automates::frozen_buchi>>,
+                          { {0, 4}, {5, 6}, {5, 7} } });
     return 0;
 }
@@ -17,7 +17,7 @@ template <class Opts>
 struct CmdOpts : Opts
 {
     using MyProp = std::variant<string Opts::*, int Opts::*, bool Opts::*, double Opts::*,
-                                uint32_t Opts::*, uint8_t Opts::*>;
+                                uint64_t Opts::*, uint32_t Opts::*, uint8_t Opts::*>;
     using MyArg = std::pair<string, MyProp>;
 
     ~CmdOpts() = default;
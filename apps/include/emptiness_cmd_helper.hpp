@@ -5,13 +5,16 @@
 #include "utils/generator.hpp"
 #include "utils/representation.hpp"
 #include "utils/converters.hpp"
+#include "utils/reduce.hpp"
 #include "statistic.hpp"
+#include "reduce/quotient.hpp"
 
 #include "LightweightParsingCMD.hpp"
 #include "TextTable.h"
 
 #include <fstream>
 #include <cmath>
+#include <limits>
 
 /// \namespace Common used functions for the Emptiness-program
 namespace emptiness_cmd_helper
@@ -33,6 +36,9 @@ There are some additional parameteres to work with generation mode. \n\
 --sets          [number]        Number of sets in final states container. Default value for NBA (1);\n\
 --edges         [number]        Number of the edges for each (not leaf and not pre-leaf) vertex in the tree.\
                                     Default value for binary tree (2);\n\
+--arena         [NONE/bool]     Construct hashed transition tables in the arena owned by the automaton \
+                                    (bump allocation, single release). Compare allocations with the default. \
+                                    Not available for the frozen (CSR) generation;\n\
 --out_file      [text]          Output file name where we will dump generated information;\n\
 ************************\n\
 \n";
@@ -48,12 +54,50 @@ struct options
     bool nba = false;
     /// \brief Invokes Nested algorithm. We use Two-stack by default (because optimal)
     bool non_optimal_only = false;
+    /// \brief Nested algorithm keeps visiting info in the packed bit array
+    bool packed = false;
+    /// \brief Nested algorithm runs the swarm of the workers with the random successors orders
+    bool swarm = false;
+    /// \brief Nested algorithm runs the cooperating workers with the shared colors (CNDFS)
+    bool cndfs = false;
+    /// \brief Invokes Couvreur's SCC-based algorithm instead of Two-stack
+    bool couvreur = false;
+    /// \brief Decomposes the automaton into SCCs (Tarjan) and prints the SCCs with final states
+    bool tarjan = false;
+    /// \brief Drops useless states (unreachable, dead ends, not reaching final sets) before conversion and checks
+    bool trim = false;
+    /// \brief Merges bisimilar states (quotient) before conversion and checks. Timed as its own phase by generator
+    bool reduce = false;
+    /// \brief Prints the accepting lasso found by Nested/Two-stack algorithm
+    bool lasso = false;
+    /// \brief Output file name where we will dump the lasso (if will exist). Enables @lasso
+    std::string lasso_file = "";
+    /// \brief Directory or list file (one path per line) of the automata checked at once. Empty means single check
+    std::string batch = "";
+    /// \brief Number of the worker threads for the parallel algorithms. 0 means all hardware threads
+    uint32_t threads = 0;
     /// \brief Input file name where we store interested automaton
     std::string in_file = "test.txt";
     /// \brief Output file name where we will dump converted automaton (if will exist)
     std::string out_file = "dump.txt";
 };
 
+/// \struct 64-bit states version of the automaton type
+/// \param T: automaton type with 16, 32 or 64-bit states
+template<typename T>
+struct widest;
+
+/// \overload
+template<template<typename> class Automaton, typename State>
+struct widest<Automaton<State>>
+{
+    using type = Automaton<uint64_t>;
+};
+
+/// \typedef 64-bit states version of the automaton type
+template<typename T>
+using widest_t = typename widest<T>::type;
+
 /// \struct Helper to save different parts of the bfs/dfs logic
 /// \note Dirty awful hack
 /// \param T: supposed automaton
@@ -69,15 +113,24 @@ struct emp_differences
     std::vector<std::string> algorithm_names;
     /// \brief Handle default usage case: calculation of the input automaton
     std::function<void(const options& opts)> user_case;
-    /// \brief Callbacks initializer for generation
+    /// \brief Callbacks initializer for generation. Command line options configure the algorithms
     std::function<emptiness_check::statistic::callbacks_handler<T>
-            (const utils::generator::generator_opts &opts)> gener_cb_init;
+            (const utils::generator::generator_opts &gen_opts, const options &opts)> gener_cb_init;
+    /// \brief Callbacks initializer for the generated automata whose states do not fit @T (see @widest_t)
+    std::function<emptiness_check::statistic::callbacks_handler<widest_t<T>>
+            (const utils::generator::generator_opts &gen_opts, const options &opts)> wide_cb_init;
+    /// \brief Pairs of the algorithms indexes (as in @algorithm_names): <serial, parallel> version of the same check
+    /// \note Every pair adds the scaling (serial / parallel time) column
+    std::vector<std::pair<std::size_t, std::size_t>> scaling = {};
 };
 
 /// \brief Read input automaton from file (if it exists) otherwise from console
+/// \param T: read automaton type (hashed, fitted hashed or fitted frozen)
 /// \param name: input file name
+/// \param degeneralized: fitted state type also fits the automaton converted to NBA
 /// \return automaton
-automates::buchi proceed_data(const std::string& name) noexcept
+template<typename T = automates::buchi>
+T proceed_data(const std::string& name, const bool degeneralized = false) noexcept
 {
     std::istream *in = &std::cin;
     std::ifstream fs;
@@ -90,16 +143,60 @@ automates::buchi proceed_data(const std::string& name) noexcept
             in = &fs;
     }
 
-    auto automat = utils::representation::construct_read(*in);
+    auto automat = [in, degeneralized]
+    {
+        if constexpr (std::is_same_v<T, utils::representation::fitted_frozen_buchi>)
+            return utils::representation::construct_read_fitted(*in, degeneralized);
+        else if constexpr (std::is_same_v<T, utils::representation::fitted_buchi>)
+            return utils::representation::construct_read_fitted_hashed(*in, degeneralized);
+        else
+            return utils::representation::construct_read(*in);
+    }();
     std::cout << "Successfully read automaton\n";
     return automat;
 }
 
+/// \brief Drop useless states of the automaton if needed
+/// \param T: automaton type (hashed or frozen)
+/// \param automaton: trimmed automaton
+/// \param opts: parsed command line options (trim flag)
+/// \return trimmed automaton (without automaton for the empty language) or nullopt if the trim is disabled
+template<typename T>
+std::optional<utils::reduce::trimmed<T>> proceed_trim(const T& automaton, const options& opts) noexcept
+{
+    if (!opts.trim)
+        return std::nullopt;
+
+    auto trimmed = std::make_optional(utils::reduce::trim(automaton));
+    std::cout << "Trim: removed " << trimmed->removed_states << " states, " << trimmed->removed_edges << " edges\n";
+
+    return trimmed;
+}
+
+/// \brief Merge bisimilar states of the automaton if needed
+/// \param T: automaton type (hashed or frozen)
+/// \param automaton: reduced automaton
+/// \param opts: parsed command line options (reduction flag and number of the workers)
+/// \return quotient automaton or nullopt if the reduction is disabled
+template<typename T>
+std::optional<T> proceed_reduction(const T& automaton, const options& opts) noexcept
+{
+    if (!opts.reduce)
+        return std::nullopt;
+
+    auto reduced = std::make_optional(emptiness_check::reduce::quotient(automaton, opts.threads));
+    std::cout << "Successfully reduced automaton\n";
+
+    return reduced;
+}
+
 /// \brief Help to convert automaton to the NBA and dump logs if needed
+/// \param T: automaton type (hashed or frozen)
 /// \param automaton: automaton for the conversation
 /// \param name: output file name. Dumping will be ignored on incorrect file
 /// \return converted automaton or nullopt in case of redundant conversion
-std::optional<automates::buchi> proceed_conversion(const automates::buchi& automaton, const std::string& name) noexcept
+template<typename T>
+std::optional<T> proceed_conversion(const T& automaton, const std::string& name) noexcept
 {
     auto converted_automat = utils::converters::nga2nba(automaton);
     // no conversion is needed
@@ -151,12 +248,48 @@ std::string time2string(const std::chrono::duration<double, std::micro>& duratio
     else return std::to_string(duration.count()) + "us";
 };
 
+/// \brief Converts bytes to human-readability
+/// \param bytes: number of bytes
+/// \return string bytes representation
+std::string bytes2string(const std::size_t bytes)
+{
+    if (bytes >= (1u << 30u))
+        return std::to_string(static_cast<double>(bytes) / (1u << 30u)) + "GB";
+    if (bytes >= (1u << 20u))
+        return std::to_string(static_cast<double>(bytes) / (1u << 20u)) + "MB";
+    if (bytes >= (1u << 10u))
+        return std::to_string(static_cast<double>(bytes) / (1u << 10u)) + "KB";
+    return std::to_string(bytes) + "B";
+}
+
+/// \brief Automaton footprint with its parts: total (transitions/finals/inverse)
+/// \param report: automaton footprint
+/// \return string footprint representation. Empty for the empty report
+std::string memory2string(const automates::memory_report& report)
+{
+    return !report.total() ? "" : bytes2string(report.total()) + " (T " + bytes2string(report.transitions) +
+                                  "/F " + bytes2string(report.finals) + "/I " + bytes2string(report.inverse) + ")";
+}
+
+/// \brief Check if the automaton tables are allocated through the memory resources (see automates::arena)
+/// \note Frozen CSR arrays are the plain vectors: their allocations can't be counted and the arena is not used
+/// \param T: automaton type
+template<typename T>
+constexpr bool is_resource_allocated = true;
+
+/// \overload
+template<typename State>
+constexpr bool is_resource_allocated<automates::basic_frozen_buchi<State>> = false;
+
 /// \brief Print user-friendly statistic table
 /// \param stats: generated statistic
 /// \param name: out file name. Otherwise console will be used
 /// \param algo_headers: headers algorithms names
+/// \param scaling: pairs of the algorithms indexes <serial, parallel> for the scaling columns
+/// \param allocs: show the allocations columns (see @is_resource_allocated)
 void print_statistic(const std::vector<emptiness_check::statistic::one_step>& stats, const std::string& name,
-                     const std::vector<std::string>& algo_headers) noexcept
+                     const std::vector<std::string>& algo_headers,
+                     const std::vector<std::pair<std::size_t, std::size_t>>& scaling, const bool allocs) noexcept
 {
     std::ostream *out = &std::cout;
     std::ofstream fs;
@@ -171,8 +304,16 @@ void print_statistic(const std::vector<emptiness_check::statistic::one_step>& st
 
     TextTable t;
 
-    std::vector<std::string> headers{"States", "Av. conversation", "Av. generation", "NGA!=NBA"};
+    std::vector<std::string> headers{"States", "Av. conversation", "Av. generation", "Av. reduction", "Conv. allocs",
+                                     "Gen. allocs", "Conv. memory", "Gen. memory", "Red. memory", "Edges (top-down)",
+                                     "NGA!=NBA"};
+    // position of the allocations columns
+    constexpr std::size_t ALLOCS_COLUMN = 4;
+    if (!allocs)
+        headers.erase(headers.begin() + ALLOCS_COLUMN, headers.begin() + ALLOCS_COLUMN + 2);
     headers.insert(std::end(headers), algo_headers.begin(), algo_headers.end());
+    for (const auto& [serial, parallel] : scaling)
+        headers.emplace_back("Scaling " + algo_headers[parallel]);
     t.addRow(headers);
 
     for (auto& stat : stats)
@@ -187,12 +328,40 @@ void print_statistic(const std::vector<emptiness_check::statistic::one_step>& st
         std::vector<std::string> container{std::to_string(stat.states),
                                            create_word(stat.average_conversion),
                                            create_word(stat.average_generation),
+                                           create_word(stat.average_reduction),
+                                           std::to_string(stat.average_conversion_allocs),
+                                           std::to_string(stat.average_generation_allocs),
+                                           memory2string(stat.average_conversion_memory),
+                                           memory2string(stat.average_generation_memory),
+                                           memory2string(stat.average_reduction_memory),
+                                           !stat.average_top_down_edges ? "" :
+                                           std::to_string(stat.average_inspected_edges) + " (" +
+                                           std::to_string(stat.average_top_down_edges) + ")",
                                            std::to_string(stat.different_results)};
-
-        for (auto& [num, durr] : stat.average_nba)
-            container.emplace_back(create_word(durr, num));
-        for (auto& [num, durr] : stat.average_nga)
-            container.emplace_back(create_word(durr, num));
+        if (!allocs)
+            container.erase(container.begin() + ALLOCS_COLUMN, container.begin() + ALLOCS_COLUMN + 2);
+
+        // algorithm time (positive answers) and peak scratch memory
+        for (std::size_t j = 0; j < stat.average_nba.size(); ++j)
+            container.emplace_back(create_word(stat.average_nba[j].second, stat.average_nba[j].first) + " " +
+                                   bytes2string(stat.peak_nba_scratch[j]));
+        for (std::size_t j = 0; j < stat.average_nga.size(); ++j)
+            container.emplace_back(create_word(stat.average_nga[j].second, stat.average_nga[j].first) + " " +
+                                   bytes2string(stat.peak_nga_scratch[j]));
+        // skipped (NGA) algorithms keep their columns empty
+        container.resize(headers.size() - scaling.size());
+
+        // speedup of the parallel version: serial time / parallel time. Zero for the skipped (NGA) algorithms
+        auto duration_of = [&stat](const std::size_t j)
+        {
+            if (j < stat.average_nba.size())
+                return stat.average_nba[j].second;
+            return j - stat.average_nba.size() < stat.average_nga.size() ?
+                   stat.average_nga[j - stat.average_nba.size()].second : call_durration::zero();
+        };
+        for (const auto& [serial, parallel] : scaling)
+            container.emplace_back(!duration_of(parallel).count() ? "" :
+                                   std::to_string(duration_of(serial) / duration_of(parallel)) + "x");
 
         t.addRow(container);
     }
@@ -206,12 +375,15 @@ void print_statistic(const std::vector<emptiness_check::statistic::one_step>& st
 /// \param repetitions: number of re-running procedure for !one automaton
 /// \param gen_opts: generation mode options
 /// \param gen_cb: callback for the initialization of the generation logic callback
+/// \param wide_cb: same for the automata whose states (NBA states for the generalized ones) do not fit @T
 /// \return gather statistic for all stages
 template<typename T>
 std::vector<emptiness_check::statistic::one_step> run_generator(const automates::buchi::atm_size repetitions,
               utils::generator::generator_opts gen_opts,
               const std::function<emptiness_check::statistic::callbacks_handler<T>
-                      (const utils::generator::generator_opts &opts)>& gen_cb) noexcept
+                      (const utils::generator::generator_opts &opts)>& gen_cb,
+              const std::function<emptiness_check::statistic::callbacks_handler<widest_t<T>>
+                      (const utils::generator::generator_opts &opts)>& wide_cb) noexcept
 {
     const auto max_opt_states = gen_opts.states;
     std::vector<emptiness_check::statistic::one_step> stats;
@@ -221,7 +393,13 @@ std::vector<emptiness_check::statistic::one_step> run_generator(const automates:
     {
         /// \note need to update gen_opts (reference inside generator callback)
         gen_opts.states = std::pow(10, i);
-        auto statistic = one_step_generation(repetitions, gen_cb(gen_opts));
+        /// \note NGA-to-NBA conversion multiplies the states by the number of the sets (see
+        ///     utils::representation::construct_read_fitted)
+        using gen_size = utils::generator::generator_opts::gen_size;
+        const auto sets = std::max<gen_size>(gen_opts.sets, 1);
+        const bool fits = gen_opts.states < std::numeric_limits<typename T::atm_size>::max() / sets;
+        auto statistic = fits ? one_step_generation(repetitions, gen_cb(gen_opts)) :
+                                one_step_generation(repetitions, wide_cb(gen_opts));
         statistic.states = gen_opts.states;
 
         stats.emplace_back(statistic);
@@ -237,14 +415,19 @@ std::vector<emptiness_check::statistic::one_step> run_generator(const automates:
 /// \param opts: generation mode options
 /// \param file_name: output file name
 /// \param headers: headers algorithms names
+/// \param scaling: pairs of the algorithms indexes <serial, parallel> for the scaling columns
 /// \param gen_cb: callback for the initialization of the generation logic callback
+/// \param wide_cb: same for the automata whose states do not fit @T
 template<typename T>
 void handle_generator_case_call(const automates::buchi::atm_size repetitions,
                                 const utils::generator::generator_opts &opts,
                                 const std::string& file_name,
                                 const std::vector<std::string>& headers,
+                                const std::vector<std::pair<std::size_t, std::size_t>>& scaling,
                                 const std::function<emptiness_check::statistic::callbacks_handler<T>
-                                        (const utils::generator::generator_opts &opts)>& gen_cb) noexcept
+                                        (const utils::generator::generator_opts &opts)>& gen_cb,
+                                const std::function<emptiness_check::statistic::callbacks_handler<widest_t<T>>
+                                        (const utils::generator::generator_opts &opts)>& wide_cb) noexcept
 {
     print_generator_info(repetitions, opts);
 
@@ -255,13 +438,13 @@ void handle_generator_case_call(const automates::buchi::atm_size repetitions,
         using namespace std::chrono;
         // starting timepoint
         auto start = high_resolution_clock::now();
-        statistics = run_generator(repetitions, opts, gen_cb);
+        statistics = run_generator(repetitions, opts, gen_cb, wide_cb);
         // ending timepoint
         auto stop = high_resolution_clock::now();
 
         duration = stop - start;
     }
-    print_statistic(statistics, file_name, headers);
+    print_statistic(statistics, file_name, headers, scaling, is_resource_allocated<T>);
 
     std::cout << "Execution took " + time2string(duration)+ "\n";
 }
@@ -284,6 +467,17 @@ void command_line(int argc, const char *argv[], const emp_differences<T>&& diffe
         {"--help", &options::help},
         {"--nba", &options::nba},
         {"--non_optimal_only", &options::non_optimal_only},
+        {"--packed", &options::packed},
+        {"--swarm", &options::swarm},
+        {"--cndfs", &options::cndfs},
+        {"--couvreur", &options::couvreur},
+        {"--tarjan", &options::tarjan},
+        {"--trim", &options::trim},
+        {"--reduce", &options::reduce},
+        {"--lasso", &options::lasso},
+        {"--lasso_file", &options::lasso_file},
+        {"--batch", &options::batch},
+        {"--threads", &options::threads},
         {"--in_file", &options::in_file},
         {"--out_file", &options::out_file},
     });
@@ -301,13 +495,25 @@ void command_line(int argc, const char *argv[], const emp_differences<T>&& diffe
                 {"--trees", &generator_opts::trees},
                 {"--sets", &generator_opts::sets},
                 {"--edges", &generator_opts::edges},
+                {"--arena", &generator_opts::arena},
             });
             auto generate_opts = gen_parser->parse(argc, argv);
-            /// \note No sense take bigger. UINTMAX < 10^10
-            generate_opts.states = std::min(static_cast<uint32_t>(generate_opts.states), 9u);
-
-            handle_generator_case_call(opts.generator, generate_opts, opts.out_file,
-                                       differences.algorithm_names, differences.gener_cb_init);
+            if (generate_opts.arena && !is_resource_allocated<T>)
+            {
+                std::cerr << "--arena is not supported: generated automata are frozen (CSR) and never hashed\n";
+                return;
+            }
+            /// \note No sense take bigger than the widest state type could number. Automata that do not fit @T are
+            ///     generated in the widest type
+            generate_opts.states = std::min<generator_opts::gen_size>(generate_opts.states,
+                    std::numeric_limits<typename widest_t<T>::atm_size>::digits10);
+
+            handle_generator_case_call<T>(opts.generator, generate_opts, opts.out_file,
+                                       differences.algorithm_names, differences.scaling,
+                                       [&differences, &opts](const generator_opts &gen_opts)
+                                       { return differences.gener_cb_init(gen_opts, opts); },
+                                       [&differences, &opts](const generator_opts &gen_opts)
+                                       { return differences.wide_cb_init(gen_opts, opts); });
         }
     }
     else
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <vector>
+#include <unordered_set>
+#include <optional>
+#include <span>
+#include <bit>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#include "automates/memory.hpp"
+
+/// \namespace Packed sets of the final set indexes: bit i is set if the state belongs to Fi
+/// \note One machine word holds up to 64 indexes. Bigger sets are packed into the several words
+namespace automates::mask
+{
+
+/// \typedef Storage unit of the packed indexes set
+using word = uint64_t;
+
+/// \brief Number of indexes in one word
+constexpr std::size_t WORD_BITS = 64;
+
+/// \brief Number of words needed for the packed set of @sets_num indexes
+/// \param sets_num: number of indexes
+/// \return number of words (at least one)
+constexpr std::size_t words_num(const std::size_t sets_num) noexcept
+{
+    return sets_num > WORD_BITS ? (sets_num + WORD_BITS - 1) / WORD_BITS : 1;
+}
+
+/// \brief Check if index @i is in the packed set
+/// \param marks: packed set
+/// \param i: index
+/// \return true if bit @i is set
+inline bool test(const std::span<const word> marks, const std::size_t i) noexcept
+{
+    return (marks[i / WORD_BITS] >> (i % WORD_BITS)) & 1u;
+}
+
+/// \brief Check if packed set is not empty
+/// \param marks: packed set
+/// \return true if at least one bit is set
+inline bool any(const std::span<const word> marks) noexcept
+{
+    for (const auto& w : marks)
+        if (w)
+            return true;
+
+    return false;
+}
+
+/// \brief Number of indexes in the packed set
+/// \param marks: packed set
+/// \return number of set bits
+inline std::size_t count(const std::span<const word> marks) noexcept
+{
+    std::size_t res = 0;
+    for (const auto& w : marks)
+        res += std::popcount(w);
+
+    return res;
+}
+
+/// \brief Union of the packed sets: dst = dst ∪ src
+/// \param[in,out] dst: packed set to extend
+/// \param src: packed set of the same size
+inline void merge(const std::span<word> dst, const std::span<const word> src) noexcept
+{
+    for (std::size_t i = 0; i < dst.size(); ++i)
+        dst[i] |= src[i];
+}
+
+/// \brief Check if packed set contains all indexes [0, sets_num)
+/// \param marks: packed set
+/// \param sets_num: number of indexes
+/// \return true if all sets are seen
+inline bool is_full(const std::span<const word> marks, const std::size_t sets_num) noexcept
+{
+    return count(marks) == sets_num;
+}
+
+} // namespace automates::mask
+
+namespace automates
+{
+
+/// \class Acceptance condition of the (Generalized) Büchi automaton: f = {F0,..Fm}, Fi ⊆ Q
+/// \details Membership is precomputed once into the packed masks of the final states (see automates::mask):
+///     one machine word per state for K <= 64 sets and mask::words_num(K) words above that. Rows are indexed by
+///     the state itself while the final states are dense enough, otherwise by the binary search over the sorted
+///     final states, so sparse state numbers cost nothing. All queries are answered without hashing and allocation
+/// \note Shared by all automaton representations (hashed and frozen transition tables)
+/// \param State: unsigned integer type of the state numbers. Instantiated for 16, 32 and 64 bits
+template<typename State>
+class basic_acceptance
+{
+    static_assert(std::is_unsigned_v<State>, "State must be an unsigned integer");
+public:
+    basic_acceptance() = delete;
+    basic_acceptance& operator=(const basic_acceptance&) = delete;
+
+    /// \typedef Automation size limitation
+    using atm_size = State;
+
+    /// \brief an initial or start state: q0 ∈ Q
+    /// \note Use NULL as default for all automates
+    static constexpr atm_size INITIAL_STATE = 0;
+
+    /// \typedef Container definition of the final states struct
+    using finals_container = std::vector<std::unordered_set<atm_size>>;
+    /// \typedef Packed (see automates::mask) read-only set of the final set indexes
+    using indexes_set = std::span<const mask::word>;
+
+    /// \brief Get number of final state
+    /// \return size of @m_final_states
+    [[nodiscard]] std::size_t get_final_num_sets() const noexcept { return m_final_states.size(); }
+
+    /// \brief Get final states sets
+    /// \return @m_final_states
+    [[nodiscard]] const finals_container& get_final_states() const noexcept { return m_final_states; }
+
+    /// \brief Check if this is Generalized Büchi automaton
+    /// \return true if is NGA (more than one set of acceptable states)
+    [[nodiscard]] bool is_generalized() const noexcept { return get_final_num_sets() > 1; }
+
+    /// \brief Number of words in each packed indexes set
+    /// \return mask::words_num(get_final_num_sets())
+    [[nodiscard]] std::size_t get_mask_words_num() const noexcept { return m_mask_words; }
+
+    /// \brief Bytes occupied by the acceptance condition
+    /// \return report with the final states part only
+    [[nodiscard]] memory_report memory_usage() const noexcept;
+
+    /// \brief Check if input number is an accept/final state
+    /// \note May be a misunderstanding for NGA
+    /// \param state: automaton state
+    /// \param set_num: specify final set number. By default check in all
+    /// \return whether state belongs to @m_final_states
+    [[nodiscard]] bool is_final(const atm_size state,
+                                const std::optional<std::size_t> set_num = std::nullopt) const noexcept
+    {
+        if (set_num)
+            // return false on too big final set index
+            return *set_num < get_final_num_sets() && mask::test(indexes_final_sets(state), *set_num);
+
+        return m_mask_words == 1 ? m_masks[mask_row(state)] : mask::any(indexes_final_sets(state));
+    }
+
+    /// \brief Denotes the set of all indices i ∈ K such that state ∈ Fi
+    /// \param state: automaton state
+    /// \return Packed set of @m_final_states indexes that contain according state
+    [[nodiscard]] indexes_set indexes_final_sets(const atm_size state) const noexcept
+    {
+        return { m_masks.data() + mask_row(state) * m_mask_words, m_mask_words };
+    }
+
+protected:
+    /// \brief Creates acceptance condition with simple input verification (by asserting)
+    /// \param finals: a correct set of sets of final states
+    explicit basic_acceptance(finals_container finals) noexcept;
+
+    /// \brief container for a set of accept states: f = {F0,..Fm}, Fi ⊆ Q
+    const finals_container m_final_states = {};
+
+private:
+    /// \brief Row of the state in @m_masks
+    /// \note Non-final states share the last (empty) row
+    /// \param state: automaton state
+    /// \return row index
+    [[nodiscard]] std::size_t mask_row(const atm_size state) const noexcept
+    {
+        // dense rows: indexed by the state itself
+        if (m_mask_states.empty())
+            return std::min<std::size_t>(state, m_masks_bound);
+
+        const auto it = std::lower_bound(m_mask_states.begin(), m_mask_states.end(), state);
+        return it != m_mask_states.end() && *it == state ? it - m_mask_states.begin() : m_masks_bound;
+    }
+
+    /// \brief number of words per state
+    std::size_t m_mask_words = 1;
+    /// \brief number of the rows before the empty one: maximal final state + 1 for the dense rows,
+    ///     number of the final states otherwise
+    std::size_t m_masks_bound = 0;
+    /// \brief final states in ascending order: row i belongs to @m_mask_states[i]. Empty for the dense rows
+    std::vector<atm_size> m_mask_states = {};
+    /// \brief packed indexes sets, @m_mask_words words per row
+    std::vector<mask::word> m_masks = {};
+};
+
+/// \typedef Default (32-bit states) acceptance condition
+using acceptance = basic_acceptance<uint32_t>;
+
+} // namespace automates
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+
+namespace automates
+{
+
+/// \enum Source of the memory for the hashed tables construction
+enum class construction
+{
+    /// \brief Every node is allocated from the heap separately
+    heap,
+    /// \brief Nodes are bump-allocated from the monotonic arena and released at once with the owner
+    arena
+};
+
+/// \typedef Shared owner of the construction arena
+using arena_ptr = std::shared_ptr<std::pmr::memory_resource>;
+
+/// \brief Create memory source for the selected construction mode
+/// \param mode: construction mode
+/// \return new monotonic arena or nullptr for the heap construction
+inline arena_ptr make_arena(const construction mode) noexcept
+{
+    return mode == construction::arena ? std::make_shared<std::pmr::monotonic_buffer_resource>() : nullptr;
+}
+
+/// \brief Memory resource to construct containers with
+/// \param arena: construction arena (may be nullptr)
+/// \return the arena itself or the default (heap) resource
+inline std::pmr::memory_resource* resource_of(const arena_ptr &arena) noexcept
+{
+    return arena ? arena.get() : std::pmr::get_default_resource();
+}
+
+} // namespace automates
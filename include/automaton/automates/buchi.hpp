@@ -1,76 +1,81 @@
 #pragma once
 
-#include <vector>
+#include "automates/acceptance.hpp"
+#include "automates/arena.hpp"
+
 #include <unordered_map>
-#include <unordered_set>
-#include <optional>
 
 #include <ostream>
 
 namespace automates
 {
 
-/// \class (Nondeterministic) Büchi automaton
-class buchi
+/// \class (Nondeterministic) Büchi automaton
+/// \param State: unsigned integer type of the state numbers. Instantiated for 16, 32 and 64 bits
+template<typename State>
+class basic_buchi : public basic_acceptance<State>
 {
 public:
-    buchi() = delete;
-    buchi& operator=(const buchi&) = delete;
-
-    /// \typedef Automation size limitation
-    using atm_size = uint32_t;
+    basic_buchi() = delete;
+    basic_buchi& operator=(const basic_buchi&) = delete;
 
-    /// \brief an initial or start state: q0 ∈ Q
-    /// \note Use NULL as default for all automates
-    static constexpr atm_size INITIAL_STATE = 0;
+    using typename basic_acceptance<State>::atm_size;
+    using typename basic_acceptance<State>::finals_container;
+    using typename basic_acceptance<State>::indexes_set;
 
-    /// \typedef Container definition of the final states struct
-    using finals_container = std::vector<std::unordered_set<atm_size>>;
     /// \typedef Container definition of the transition table struct
-    using table_container = std::unordered_map<atm_size, std::unordered_set<atm_size>>;
-    /// \typedef Container definition of the final set indexes
-    using indexes_set = std::vector<atm_size>;
+    /// \note Polymorphic allocator: the nested sets are placed into the same memory resource as the table
+    using table_container = std::pmr::unordered_map<atm_size, std::pmr::unordered_set<atm_size>>;
+    /// \typedef Read-only range of the state successors
+    using successors_range = const std::pmr::unordered_set<atm_size>&;
 
-    /// \brief Creates an Büchi object with simple input verification (by asserting)
+    /// \brief Creates an Büchi object with simple input verification (by asserting)
     /// \param finals: a correct set of sets of final states
     /// \param trans_table: a correct transition table (map<state, set<next_state>>)
-    explicit buchi(finals_container finals, table_container trans_table) noexcept;
-
-    /// \brief Get number of final state
-    /// \return size of @m_final_states
-    [[nodiscard]] atm_size get_final_num_sets() const noexcept { return m_final_states.size(); }
-
-    /// \brief Check if this is Generalized Büchi automaton
-    /// \return true if is NGA (more than one set of acceptable states)
-    [[nodiscard]] bool is_generalized() const noexcept { return get_final_num_sets() > 1; }
-
-    /// \brief Check if input number is an accept/final state
-    /// \note May be a misunderstanding for NGA
+    /// \param arena: arena that @trans_table was constructed in. Automaton keeps it alive
+    explicit basic_buchi(finals_container finals, table_container trans_table, arena_ptr arena = nullptr) noexcept;
+
+    /// \brief Copy keeps the construction mode: arena-backed table is copied into the new own arena
+    /// \note Also used instead of moving (constant table)
+    /// \param other: copied automaton
+    basic_buchi(const basic_buchi& other) noexcept;
+
+    /// \brief How the transition table was constructed
+    /// \return arena if the table lives in the owned arena, heap otherwise
+    [[nodiscard]] construction get_construction() const noexcept
+    {
+        return m_arena ? construction::arena : construction::heap;
+    }
+
+    /// \brief All states reachable from @state by one transition
     /// \param state: automaton state
-    /// \param set_num: specify final set number. By default check in all
-    /// \return whether state belongs to @m_final_states
-    [[nodiscard]] bool is_final(atm_size state, std::optional<atm_size> set_num = std::nullopt) const noexcept;
+    /// \return successors set (empty for the states without outgoing transitions)
+    [[nodiscard]] successors_range successors(atm_size state) const noexcept;
 
-    /// \brief Denotes the set of all indices i ∈ K such that state ∈ Fi
-    /// \note Sorted ascending and unique
-    /// \param state: automaton state
-    /// \return Sorted ascending and unique vector of @m_final_states indexes that contain according state
-    [[nodiscard]] indexes_set indexes_final_sets(atm_size state) const noexcept;
+    /// \brief Bytes occupied by the automaton
+    /// \return report with the transitions and final states parts
+    [[nodiscard]] memory_report memory_usage() const noexcept;
 
-    /// \brief Simple and user-friendly Büchi automaton representation
-    ///     "-NUM->" - means NUM symbol for acceptable transition
-    ///     \file representation.cpp
-    /// \param out: output stream
-    /// \param automaton: automaton that will be printed
-    /// \return output stream
-    friend std::ostream& operator<<(std::ostream& out, const buchi& automaton);
+private:
+    /// \brief construction arena of the transition table
+    /// \note Declared before the table to outlive it
+    const arena_ptr m_arena = nullptr;
 
+public:
     /// \brief container for a transition function: δ: Q x Q → ∑
     const table_container m_trans_table = {};
-protected:
-    /// \brief container for a set of accept states: f = {F0,..Fm}, Fi ⊆ Q
-    const finals_container m_final_states = {};
-
 };
 
+/// \brief Simple and user-friendly Büchi automaton representation
+///     "-NUM->" - means NUM symbol for acceptable transition
+///     \file representation.cpp
+/// \param out: output stream
+/// \param automaton: automaton that will be printed
+/// \return output stream
+template<typename State>
+std::ostream& operator<<(std::ostream& out, const basic_buchi<State>& automaton);
+
+/// \typedef Default (32-bit states) Büchi automaton
+using buchi = basic_buchi<uint32_t>;
+
 } // namespace automates
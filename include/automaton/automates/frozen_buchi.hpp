@@ -0,0 +1,113 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+
+#include <span>
+
+#include <ostream>
+
+namespace automates
+{
+
+/// \class Immutable ("frozen") (Nondeterministic) Büchi automaton
+/// \details Transition table is stored in CSR (compressed sparse row) form: successors of the state q are
+///     @m_successors[@m_offsets[q], @m_offsets[q + 1]), sorted ascending and unique. Expansion of the state is
+///     an index computation over the contiguous arrays: no hashing and no node-based buckets.
+/// \note Rows are indexed by the state number itself, so sparse state numbers cost one offset per skipped state
+/// \param State: unsigned integer type of the state numbers. Instantiated for 16, 32 and 64 bits
+template<typename State>
+class basic_frozen_buchi : public basic_acceptance<State>
+{
+public:
+    basic_frozen_buchi() = delete;
+    basic_frozen_buchi(const basic_frozen_buchi&) = default;
+    basic_frozen_buchi(basic_frozen_buchi&&) noexcept = default;
+    basic_frozen_buchi& operator=(const basic_frozen_buchi&) = delete;
+
+    using typename basic_acceptance<State>::atm_size;
+    using typename basic_acceptance<State>::finals_container;
+    using typename basic_acceptance<State>::indexes_set;
+
+    /// \typedef Hashed transition table (the source of freezing)
+    using table_container = typename basic_buchi<State>::table_container;
+    /// \typedef One transition: <from, to>
+    using edge = std::pair<atm_size, atm_size>;
+    /// \typedef Container definition of the transitions list
+    using edges_container = std::vector<edge>;
+    /// \typedef Container definition of the row offsets
+    using offsets_container = std::vector<std::size_t>;
+    /// \typedef Container definition of the concatenated successors rows
+    using csr_container = std::vector<atm_size>;
+    /// \typedef Contiguous read-only range of the state successors
+    using successors_range = std::span<const atm_size>;
+
+    /// \brief Freeze hashed transition table
+    /// \param finals: a correct set of sets of final states
+    /// \param trans_table: a correct transition table (map<state, set<next_state>>)
+    explicit basic_frozen_buchi(finals_container finals, const table_container &trans_table) noexcept;
+
+    /// \brief Build directly from the list of transitions. Duplicates are allowed and removed
+    /// \param finals: a correct set of sets of final states
+    /// \param edges: not empty list of transitions in any order
+    explicit basic_frozen_buchi(finals_container finals, edges_container edges) noexcept;
+
+    /// \brief Adopt already built CSR arrays. Rows will be sorted
+    /// \param finals: a correct set of sets of final states
+    /// \param offsets: row offsets, offsets.size() == states bound + 1, offsets.back() == successors.size()
+    /// \param successors: concatenated rows without duplicates inside one row
+    explicit basic_frozen_buchi(finals_container finals, offsets_container offsets,
+                                csr_container successors) noexcept;
+
+    /// \brief Freeze already constructed automaton
+    /// \param automat: hashed Büchi automaton
+    explicit basic_frozen_buchi(const basic_buchi<State> &automat) noexcept;
+
+    /// \brief All states reachable from @state by one transition
+    /// \param state: automaton state
+    /// \return sorted contiguous successors range (empty for the states without outgoing transitions)
+    [[nodiscard]] successors_range successors(const atm_size state) const noexcept
+    {
+        if (state >= get_states_bound())
+            return {};
+
+        const auto row = static_cast<std::size_t>(state);
+        return { m_successors.data() + m_offsets[row], m_successors.data() + m_offsets[row + 1] };
+    }
+
+    /// \brief Exclusive upper bound of the state numbers that have a row
+    /// \return number of the rows in the table
+    [[nodiscard]] std::size_t get_states_bound() const noexcept { return m_offsets.size() - 1; }
+
+    /// \brief Number of the stored transitions
+    /// \return size of @m_successors
+    [[nodiscard]] std::size_t get_edges_num() const noexcept { return m_successors.size(); }
+
+    /// \brief Bytes occupied by the automaton
+    /// \return report with the transitions (CSR arrays) and final states parts
+    [[nodiscard]] memory_report memory_usage() const noexcept
+    {
+        auto report = basic_acceptance<State>::memory_usage();
+        report.transitions = memory::vector_bytes(m_offsets) + memory::vector_bytes(m_successors);
+
+        return report;
+    }
+
+private:
+    /// \brief row offsets: @m_offsets[q] is the first successor index of the state q
+    offsets_container m_offsets = {};
+    /// \brief successors of all states row by row
+    csr_container m_successors = {};
+};
+
+/// \brief Same format as hashed Büchi automaton representation
+///     \file representation.cpp
+/// \param out: output stream
+/// \param automaton: automaton that will be printed
+/// \return output stream
+template<typename State>
+std::ostream& operator<<(std::ostream& out, const basic_frozen_buchi<State>& automaton);
+
+/// \typedef Default (32-bit states) frozen Büchi automaton
+using frozen_buchi = basic_frozen_buchi<uint32_t>;
+
+} // namespace automates
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "automates/acceptance.hpp"
+
+#include <functional>
+
+namespace automates
+{
+
+/// \class On-the-fly (implicit) Büchi automaton: A = (Q, q0, δ, f) given by the successor and the acceptance
+///     functions instead of the stored tables
+/// \details States are generated only when the search expands them, so the search may stop at the first lasso
+///     without building the whole graph. The successors are appended to the buffer of the caller: the search keeps
+///     them on its own stack while the state is expanded
+/// \note The initial state is 0 as in all automata of the library
+/// \param State: unsigned integer type of the state numbers. Instantiated for 16, 32 and 64 bits
+template<typename State>
+class basic_implicit_buchi
+{
+    static_assert(std::is_unsigned_v<State>, "State must be an unsigned integer");
+public:
+    /// \typedef Automation size limitation
+    using atm_size = State;
+
+    /// \brief an initial or start state: q0 ∈ Q
+    static constexpr atm_size INITIAL_STATE = 0;
+
+    /// \typedef Packed (see automates::mask) read-only set of the final set indexes
+    using indexes_set = std::span<const mask::word>;
+    /// \typedef Buffer the successors are generated into
+    using successors_buffer = std::vector<atm_size>;
+
+    virtual ~basic_implicit_buchi() = default;
+
+    /// \brief Generate successors of the state: δ(state)
+    /// \param state: expanded state
+    /// \param[out] out: successors are appended to the buffer
+    virtual void successors(atm_size state, successors_buffer &out) const noexcept = 0;
+
+    /// \brief Denotes the set of all indices i ∈ K such that state ∈ Fi
+    /// \note The set may be invalidated by the next call
+    /// \param state: automaton state
+    /// \return Packed set of get_mask_words_num() words
+    [[nodiscard]] virtual indexes_set acceptance(atm_size state) const noexcept = 0;
+
+    /// \brief Get number of final sets
+    /// \return K
+    [[nodiscard]] std::size_t get_final_num_sets() const noexcept { return m_sets_num; }
+
+    /// \brief Check if this is Generalized Büchi automaton
+    /// \return true if is NGA (more than one set of acceptable states)
+    [[nodiscard]] bool is_generalized() const noexcept { return get_final_num_sets() > 1; }
+
+    /// \brief Number of words in each packed indexes set
+    /// \return mask::words_num(get_final_num_sets())
+    [[nodiscard]] std::size_t get_mask_words_num() const noexcept { return m_mask_words; }
+
+    /// \brief Check if input number is an accept/final state
+    /// \param state: automaton state
+    /// \param set_num: specify final set number. By default check in all
+    /// \return whether state belongs to the final sets
+    [[nodiscard]] bool is_final(const atm_size state,
+                                const std::optional<std::size_t> set_num = std::nullopt) const noexcept
+    {
+        if (set_num)
+            // return false on too big final set index
+            return *set_num < get_final_num_sets() && mask::test(acceptance(state), *set_num);
+
+        return mask::any(acceptance(state));
+    }
+
+    /// \brief Same as @acceptance: the stored tables interface
+    /// \param state: automaton state
+    /// \return Packed set of the final sets indexes that contain according state
+    [[nodiscard]] indexes_set indexes_final_sets(const atm_size state) const noexcept { return acceptance(state); }
+
+protected:
+    /// \brief Creates the acceptance condition shape
+    /// \param sets_num: number of the final sets (K >= 1)
+    explicit basic_implicit_buchi(std::size_t sets_num) noexcept;
+
+private:
+    /// \brief number of the final sets
+    std::size_t m_sets_num;
+    /// \brief number of words per packed indexes set
+    std::size_t m_mask_words;
+};
+
+/// \class Implicit automaton built from the callbacks
+/// \param State: unsigned integer type of the state numbers
+template<typename State>
+class basic_callback_buchi final : public basic_implicit_buchi<State>
+{
+public:
+    /// \typedef Successor function: appends δ(state) to the buffer
+    using successors_fn = std::function<void(State, std::vector<State>&)>;
+    /// \typedef Acceptance function: sets bits of the final sets indexes in the cleared packed set
+    using acceptance_fn = std::function<void(State, std::span<mask::word>)>;
+
+    /// \brief Create the automaton
+    /// \param sets_num: number of the final sets (K >= 1)
+    /// \param succ: successor function
+    /// \param acc: acceptance function
+    basic_callback_buchi(std::size_t sets_num, successors_fn succ, acceptance_fn acc) noexcept;
+
+    void successors(State state, std::vector<State> &out) const noexcept override { m_successors(state, out); }
+
+    [[nodiscard]] typename basic_implicit_buchi<State>::indexes_set acceptance(State state) const noexcept override;
+
+private:
+    /// \brief successor function
+    successors_fn m_successors;
+    /// \brief acceptance function
+    acceptance_fn m_acceptance;
+    /// \brief packed set of the last @acceptance call
+    mutable std::vector<mask::word> m_marks;
+};
+
+/// \typedef Default (32-bit states) implicit automaton
+using implicit_buchi = basic_implicit_buchi<uint32_t>;
+/// \typedef Default (32-bit states) callback automaton
+using callback_buchi = basic_callback_buchi<uint32_t>;
+
+} // namespace automates
@@ -6,22 +6,34 @@ namespace automates
 {
 
 // TODO: Karlion refactor
-class inv_buchi : public buchi
+/// \param State: unsigned integer type of the state numbers. Instantiated for 16, 32 and 64 bits
+template<typename State>
+class basic_inv_buchi : public basic_buchi<State>
 {
 public:
-    explicit inv_buchi(buchi&& automat) noexcept;
+    using typename basic_buchi<State>::atm_size;
+    using typename basic_buchi<State>::table_container;
+
+    explicit basic_inv_buchi(basic_buchi<State>&& automat) noexcept;
 
     [[nodiscard]]
-    std::optional<table_container::const_iterator> acceptable_inv_transitions(atm_size state) const noexcept;
+    std::optional<typename table_container::const_iterator> acceptable_inv_transitions(atm_size state) const noexcept;
+
+    /// \brief Bytes occupied by the automaton
+    /// \return report with the transitions, final states and inverse (table and states set) parts
+    [[nodiscard]] memory_report memory_usage() const noexcept;
 
-    const std::unordered_set<atm_size> m_set_of_states = {};
+    const std::pmr::unordered_set<atm_size> m_set_of_states = {};
 private:
     const table_container m_trans_table_inv = {};
 
     static table_container inverse_trans_table(const table_container &trans_table) noexcept;
 
-    static std::unordered_set<atm_size> collect_states(const table_container &trans_table) noexcept;
+    static std::pmr::unordered_set<atm_size> collect_states(const table_container &trans_table) noexcept;
 
 };
 
+/// \typedef Default (32-bit states) Büchi automaton with inverse transition table
+using inv_buchi = basic_inv_buchi<uint32_t>;
+
 } // namespace automates
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace automates
+{
+
+/// \struct Bytes occupied by the automaton parts
+struct memory_report
+{
+    /// \brief Transition table (hashed or CSR)
+    std::size_t transitions = 0;
+    /// \brief Final states sets together with the packed acceptance masks
+    std::size_t finals = 0;
+    /// \brief Inverse transition table and derived sets (inverse automaton only)
+    std::size_t inverse = 0;
+
+    /// \brief Sum of all parts
+    /// \return total bytes
+    [[nodiscard]] std::size_t total() const noexcept { return transitions + finals + inverse; }
+};
+
+/// \namespace Estimation of the containers footprint
+/// \note Counts the payload, node links and bucket arrays. Allocator headers and padding are not included
+namespace memory
+{
+
+/// \brief Bytes of the vector storage
+/// \param v: vector
+/// \return reserved bytes
+template<typename T, typename A>
+std::size_t vector_bytes(const std::vector<T, A> &v) noexcept
+{
+    return v.capacity() * sizeof(T);
+}
+
+/// \brief Bytes of one node of the hashed container (next link + value)
+/// \param C: hashed container type
+/// \return node bytes
+template<typename C>
+constexpr std::size_t node_bytes() noexcept
+{
+    return sizeof(void*) + sizeof(typename C::value_type);
+}
+
+/// \brief Bytes of the hashed container: bucket array and nodes. Nested containers are not included
+/// \param c: hashed container
+/// \param nodes: number of nodes to account (e.g. peak size of the shrinking container)
+/// \return estimated bytes
+template<typename C>
+std::size_t hashed_bytes(const C &c, const std::size_t nodes) noexcept
+{
+    return c.bucket_count() * sizeof(void*) + nodes * node_bytes<C>();
+}
+
+/// \overload
+template<typename C>
+std::size_t hashed_bytes(const C &c) noexcept
+{
+    return hashed_bytes(c, c.size());
+}
+
+/// \brief Bytes of the hashed table of hashed containers (transition table)
+/// \param table: map<state, set<state>>
+/// \return estimated bytes including all nested sets
+template<typename C>
+std::size_t nested_hashed_bytes(const C &table) noexcept
+{
+    std::size_t bytes = hashed_bytes(table);
+    for (const auto& [_, set] : table)
+        bytes += hashed_bytes(set);
+
+    return bytes;
+}
+
+} // namespace memory
+
+} // namespace automates
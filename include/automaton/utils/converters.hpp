@@ -1,13 +1,30 @@
 #pragma once
 
 #include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
 
 namespace utils::converters
 {
 
 /// \brief Conversion operation from NGA to NBA automaton
+/// \details NBA has up to (states number) * (number of final sets) states. The conversion aborts when they do not fit
+///     @State (see utils::representation::construct_read_fitted for the fitting type)
+/// \note Temporary containers are bump-allocated from the local arena.
+///     The result keeps the construction mode (heap or arena) of @automat
+/// \param State: state type of the automaton
 /// \param automat: NGA automaton
 /// \return NBA automaton or nullopt if @automat is already NBA
-std::optional<automates::buchi> nga2nba(const automates::buchi& automat) noexcept;
+template<typename State>
+std::optional<automates::basic_buchi<State>> nga2nba(const automates::basic_buchi<State>& automat) noexcept;
+
+/// \brief Conversion operation from NGA to NBA frozen automaton
+/// \note Paired states <state, set index> are numbered through the dense array instead of hashing.
+///     Aborts when they do not fit @State
+/// \param State: state type of the automaton
+/// \param automat: NGA automaton
+/// \return NBA automaton or nullopt if @automat is already NBA
+template<typename State>
+std::optional<automates::basic_frozen_buchi<State>> nga2nba(
+        const automates::basic_frozen_buchi<State>& automat) noexcept;
 
 } // namespace utils::converters
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
 
 namespace utils::generator
 {
@@ -8,18 +9,24 @@ namespace utils::generator
 /// \struct Handle generator options to help with randomization and limitation of the output automaton size
 struct generator_opts
 {
+    /// \typedef Number of the generated items. Independent of the generated automaton state type
+    using gen_size = uint64_t;
+
     /// \brief Number of states for the automaton. Random not very small default value
-    automates::buchi::atm_size states = 5;
+    gen_size states = 5;
     /// \brief Number of generated trees for the transition table.
     /// Default value is a minimal for really similar table
-    automates::buchi::atm_size trees = 2;
+    gen_size trees = 2;
     /// \brief Number of sets in final states container.
     /// Default value for NBA
-    automates::buchi::atm_size sets = 1;
+    gen_size sets = 1;
     /// \brief Number of the edges for each (not leaf and not pre-leaf) vertex in the tree.
     /// Default value for binary tree
     /// \note: +1 for self-cycle
-    automates::buchi::atm_size edges = 2;
+    gen_size edges = 2;
+    /// \brief Construct hashed transition table in the arena owned by the automaton.
+    /// Default value for the separate heap allocations
+    bool arena = false;
 };
 
 /// \brief Generate random Buchi automaton. Emptiness will cause assertion
@@ -29,8 +36,19 @@ struct generator_opts
 ///     first tree, that will be constructed from !all @opts.states. Also, we generate @opts.sets for final states.
 ///     Number equals to 1 will mean NBA construction. Maximal amount of the states for each set will be
 ///     !experimentally calculated with this formula: max_in_set = @opts.states / @opts.sets / @opts.edges
+/// \note: Transition table construction mode is selected by @opts.arena
+/// \param State: state type of the generated automaton. @opts.states must fit into it
 /// \param opts: generator options
 /// \return random Buchi automaton
-automates::buchi generate_automaton(const generator_opts& opts) noexcept;
+template<typename State = uint32_t>
+automates::basic_buchi<State> generate_automaton(const generator_opts& opts) noexcept;
+
+/// \brief Generate random frozen (CSR) Buchi automaton. Same generation rules as @generate_automaton
+/// \note: Merged trees transitions are frozen at once, without hashed table. @opts.arena is not used
+/// \param State: state type of the generated automaton. @opts.states must fit into it
+/// \param opts: generator options
+/// \return random frozen Buchi automaton
+template<typename State = uint32_t>
+automates::basic_frozen_buchi<State> generate_frozen_automaton(const generator_opts& opts) noexcept;
 
 } // namespace utils::generator
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+#include "automates/implicit_buchi.hpp"
+
+#include <functional>
+
+namespace utils::product
+{
+
+/// \class On-the-fly product of the system graph and the Büchi property automaton: S ⊗ A
+/// \details The product is the implicit automaton: a state is expanded only when the emptiness search asks for
+///     its successors, so the unreachable and the never explored pairs are never built. The pair
+///     <system state s, property state p> is encoded arithmetically as s * |P| + p (|P| is the property states
+///     bound): no table of the visited pairs besides the one the search keeps anyway. The pair that does not fit
+///     @State stops the program: choose the wider @State for the bigger systems.
+///     (s, p) -> (s', p') iff s -> s' in the system, p -> p' in the property and @guard(s', p') holds.
+///     The pair is accepting in the final set i iff p ∈ Fi
+/// \note Initial pair (0, 0) is encoded as 0: the initial state of the product
+/// \param State: unsigned integer type of the state numbers. Instantiated for 16, 32 and 64 bits
+template<typename State>
+class basic_engine final : public automates::basic_implicit_buchi<State>
+{
+public:
+    using typename automates::basic_implicit_buchi<State>::atm_size;
+    using typename automates::basic_implicit_buchi<State>::indexes_set;
+    using typename automates::basic_implicit_buchi<State>::successors_buffer;
+
+    /// \typedef System transition source: appends the successors of the system state to the buffer.
+    ///     The initial system state is 0
+    using system_fn = std::function<void(State, std::vector<State>&)>;
+    /// \typedef Labels compatibility: true if the system state satisfies the letter of the property state
+    using guard_fn = std::function<bool(State, State)>;
+
+    /// \brief Pair the system with the property
+    /// \param system: system transition source
+    /// \param property: property automaton
+    /// \param guard: optional labels compatibility. All pairs are compatible without it
+    basic_engine(system_fn system, automates::basic_frozen_buchi<State> property, guard_fn guard = {}) noexcept;
+
+    /// \overload
+    /// \note The hashed property is frozen once
+    basic_engine(system_fn system, const automates::basic_buchi<State> &property, guard_fn guard = {}) noexcept;
+
+    void successors(atm_size state, successors_buffer &out) const noexcept override;
+
+    [[nodiscard]] indexes_set acceptance(const atm_size state) const noexcept override
+    {
+        return m_property.indexes_final_sets(property_state(state));
+    }
+
+    /// \brief Encode the pair
+    /// \note Aborts when the pair does not fit the state type (see @max_system_state)
+    /// \param system: system state
+    /// \param property: property state (less than the property states bound)
+    /// \return product state
+    [[nodiscard]] atm_size encode(const atm_size system, const atm_size property) const noexcept
+    {
+        if (system > m_max_system)
+            overflow(system);
+
+        return static_cast<atm_size>(system * m_width + property);
+    }
+
+    /// \brief The biggest system state that is encoded with every property state
+    /// \return system states bound of the encoding
+    [[nodiscard]] atm_size max_system_state() const noexcept { return m_max_system; }
+
+    /// \brief System part of the product state
+    /// \param state: product state
+    /// \return system state
+    [[nodiscard]] atm_size system_state(const atm_size state) const noexcept
+    {
+        return static_cast<atm_size>(state / m_width);
+    }
+
+    /// \brief Property part of the product state
+    /// \param state: product state
+    /// \return property state
+    [[nodiscard]] atm_size property_state(const atm_size state) const noexcept
+    {
+        return static_cast<atm_size>(state % m_width);
+    }
+
+    /// \brief Paired property automaton
+    /// \return frozen property
+    [[nodiscard]] const automates::basic_frozen_buchi<State>& property() const noexcept { return m_property; }
+
+    /// \brief Number of the product states expanded so far
+    /// \return @successors calls
+    [[nodiscard]] std::size_t expanded() const noexcept { return m_expanded; }
+
+private:
+    /// \brief Report the system state that can not be encoded and stop
+    /// \note Wrapped product states would silently search another product
+    /// \param system: system state
+    [[noreturn]] static void overflow(atm_size system) noexcept;
+
+    /// \brief system transition source
+    system_fn m_system;
+    /// \brief property automaton
+    automates::basic_frozen_buchi<State> m_property;
+    /// \brief labels compatibility (may be empty)
+    guard_fn m_guard;
+    /// \brief property states bound: multiplier of the system part in the encoding
+    atm_size m_width;
+    /// \brief the biggest encoded system state: @m_max_system * @m_width + (@m_width - 1) fits @State
+    atm_size m_max_system;
+    /// \brief system successors of the expanded state
+    mutable std::vector<State> m_system_successors = {};
+    /// \brief number of the expanded product states
+    mutable std::size_t m_expanded = 0;
+};
+
+/// \typedef Default (32-bit states) product engine
+using engine = basic_engine<uint32_t>;
+
+} // namespace utils::product
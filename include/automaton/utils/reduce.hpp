@@ -0,0 +1,46 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+#include "automates/inv_buchi.hpp"
+
+namespace utils::reduce
+{
+
+/// \struct Trimmed automaton with the size of the removed part
+/// \param T: automaton type
+template<typename T>
+struct trimmed
+{
+    /// \brief automaton without useless states or nullopt if nothing is left (the language is empty)
+    std::optional<T> automaton;
+    /// \brief number of the removed states (transitions ends and the initial state)
+    std::size_t removed_states = 0;
+    /// \brief number of the removed transitions
+    std::size_t removed_edges = 0;
+};
+
+/// \brief Drop states that lie on no accepting run: unreachable from INITIAL_STATE, dead ends and states that
+///     can't reach some final set
+/// \details Forward search over the direct table collects the reachable states. Then, until nothing changes,
+///     dead ends are peeled off along the inverse table and backward searches from every final set (inside the
+///     kept states) cut the states that can't reach it, and the forward search drops the states cut off from
+///     INITIAL_STATE. Kept states keep their numbers
+/// \note Every remaining state reaches all final sets: for NBA the nonempty result means the nonempty language
+/// \param State: state type of the automaton
+/// \param automat: automaton with the inverse transition table
+/// \return trimmed automaton (the construction mode of @automat is kept) and removed states and edges numbers
+template<typename State>
+trimmed<automates::basic_buchi<State>> trim(const automates::basic_inv_buchi<State> &automat) noexcept;
+
+/// \overload
+/// \note Builds the inverse table first
+template<typename State>
+trimmed<automates::basic_buchi<State>> trim(const automates::basic_buchi<State> &automat) noexcept;
+
+/// \overload
+/// \note Dense flags and the inverse CSR table instead of the hashed sets. Rows of the removed states are empty
+template<typename State>
+trimmed<automates::basic_frozen_buchi<State>> trim(const automates::basic_frozen_buchi<State> &automat) noexcept;
+
+} // namespace utils::reduce
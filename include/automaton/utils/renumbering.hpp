@@ -0,0 +1,59 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+
+namespace utils::renumbering
+{
+
+/// \enum Order in which states receive new dense numbers
+enum class order
+{
+    /// \brief Breadth-first discovery order
+    bfs,
+    /// \brief Depth-first discovery (preorder) order
+    dfs,
+    /// \brief Cuthill–McKee: breadth-first over the undirected graph with the neighbours sorted by degree.
+    /// Bandwidth-reducing ordering (not reversed to keep initial state as 0)
+    cuthill_mckee
+};
+
+/// \struct Renumbered automaton with the way back to the original states
+/// \param T: automaton type
+template<typename T>
+struct renumbered
+{
+    /// \brief automaton with dense states 0..n-1
+    T automaton;
+    /// \brief original state for each new one: origin[new_state] = old_state
+    std::vector<typename T::atm_size> origin;
+};
+
+/// \brief Compact sparse states into the dense 0..n-1 numbers in the selected locality order
+/// \details Discovery starts from INITIAL_STATE, so it keeps number 0. States unreachable from it are numbered
+///     afterwards, also in the selected order, starting from the smallest original state
+/// \param State: state type of the automaton
+/// \param automat: automaton with arbitrary state numbers
+/// \param ord: numbering order
+/// \return renumbered automaton and mapping to the original states
+template<typename State>
+renumbered<automates::basic_buchi<State>> renumber(const automates::basic_buchi<State> &automat,
+                                                   order ord = order::bfs) noexcept;
+
+/// \overload
+template<typename State>
+renumbered<automates::basic_frozen_buchi<State>> renumber(const automates::basic_frozen_buchi<State> &automat,
+                                                          order ord = order::bfs) noexcept;
+
+/// \brief Compact the hashed automaton and freeze it in one pass
+/// \details Same numbering as @renumber, but the new rows are written straight into the CSR arrays
+///     without the intermediate hashed copy
+/// \param State: state type of the automaton
+/// \param automat: automaton with arbitrary state numbers
+/// \param ord: numbering order
+/// \return frozen renumbered automaton and mapping to the original states
+template<typename State>
+renumbered<automates::basic_frozen_buchi<State>> renumber_frozen(const automates::basic_buchi<State> &automat,
+                                                                 order ord = order::bfs) noexcept;
+
+} // namespace utils::renumbering
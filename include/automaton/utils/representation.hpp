@@ -1,9 +1,11 @@
 #pragma once
 
 #include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
 
 #include <istream>
 #include <memory>
+#include <variant>
 
 namespace utils::representation
 {
@@ -20,8 +22,45 @@ namespace utils::representation
 ///             symbol num - symbol that accepts state num
 ///             successor num - state after acceptancy
 /// \note: Hints will be printed to the std::cout in case of in == std::cin
+/// \param State: state type of the constructed automaton. All read states must fit
 /// \param in: input stream
+/// \param mode: memory source of the transition table nodes
 /// \return constructed automaton
-automates::buchi construct_read(std::istream &in) noexcept;
+template<typename State = uint32_t>
+automates::basic_buchi<State> construct_read(std::istream &in,
+                                             automates::construction mode = automates::construction::heap) noexcept;
+
+/// \brief Construct frozen (CSR) Büchi automaton from input stream. Same format as @construct_read
+/// \note: Transitions are collected into the plain list and frozen at once, without hashed table
+/// \param State: state type of the constructed automaton. All read states must fit
+/// \param in: input stream
+/// \return constructed automaton
+template<typename State = uint32_t>
+automates::basic_frozen_buchi<State> construct_read_frozen(std::istream &in) noexcept;
+
+/// \typedef Frozen Büchi automaton of the one of the supported state types
+using fitted_frozen_buchi = std::variant<automates::basic_frozen_buchi<uint16_t>,
+                                         automates::basic_frozen_buchi<uint32_t>,
+                                         automates::basic_frozen_buchi<uint64_t>>;
+
+/// \brief Construct frozen Büchi automaton with the smallest state type that fits all read states
+/// \note: Same format as @construct_read
+/// \param in: input stream
+/// \param degeneralized: the type must also fit the states of the automaton converted to NBA
+///     (utils::converters::nga2nba): up to (biggest state + 1) * (number of final sets) states
+/// \return constructed automaton
+fitted_frozen_buchi construct_read_fitted(std::istream &in, bool degeneralized = false) noexcept;
+
+/// \typedef Hashed Büchi automaton of the one of the supported state types
+using fitted_buchi = std::variant<automates::basic_buchi<uint16_t>,
+                                  automates::basic_buchi<uint32_t>,
+                                  automates::basic_buchi<uint64_t>>;
+
+/// \brief Construct hashed Büchi automaton with the smallest state type that fits all read states
+/// \note: Same format and fitting as @construct_read_fitted. The table is built on the heap
+/// \param in: input stream
+/// \param degeneralized: the type must also fit the states of the automaton converted to NBA
+/// \return constructed automaton
+fitted_buchi construct_read_fitted_hashed(std::istream &in, bool degeneralized = false) noexcept;
 
 }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "automates/frozen_buchi.hpp"
+#include "utils/representation.hpp"
+
+#include <functional>
+#include <memory_resource>
+#include <span>
+#include <string>
+
+/// \brief Emptiness checks of many independent automata at once
+namespace emptiness_check::batch
+{
+
+/// \typedef Check of one automaton. Second argument is the scratch memory of the worker, third one receives peak
+///     scratch bytes
+/// \param T: automaton type
+template<typename T>
+using check_fn = std::function<bool(const T &, std::pmr::memory_resource *, std::size_t *)>;
+
+/// \struct Results of the batch
+struct report
+{
+    /// \brief emptiness of each automaton in the input order. Nullopt for the input that could not be read
+    std::vector<std::optional<bool>> results = {};
+    /// \brief number of the checks done by each worker
+    std::vector<std::size_t> checks = {};
+    /// \brief peak scratch bytes of each worker
+    std::vector<std::size_t> scratch_peak = {};
+};
+
+/// \brief Check all automata on the pool of the workers
+/// \details Automata are scheduled one by one with the work stealing (parallel::for_each_stealing), so a few big
+///     automata do not hold the rest of the batch. Every worker keeps its own slot: counters and the scratch pool
+///     resource. The pool keeps the blocks of the finished checks, so the next check of the worker reuses them
+///     instead of asking the heap (the default two-stack check allocates all its search structures there)
+/// \param T: automaton type (frozen or fitted frozen)
+/// \param automata: checked automata
+/// \param fn: check of one automaton. Two-stack by default
+/// \param threads: number of the workers (including the calling thread). 0 means all hardware threads
+/// \return results in the input order with the per-worker statistic
+template<typename T>
+report check(std::span<const T> automata, const check_fn<T> &fn = {}, unsigned threads = 0) noexcept;
+
+/// \brief Read and check the automata files on the pool of the workers
+/// \details Files are handled by the windows: the next window is read (and parsed) by the reader thread while the
+///     workers check the current one
+/// \param paths: input files (format of utils::representation::construct_read)
+/// \param fn: check of one automaton. Two-stack by default
+/// \param threads: number of the workers (including the calling thread). 0 means all hardware threads
+/// \param window: number of the files read ahead. 0 means four files per worker
+/// \param degeneralized: state types also fit the automata converted to NBA (see
+///     utils::representation::construct_read_fitted)
+/// \return results in the input order (nullopt for the files that could not be opened) with the per-worker statistic
+report check(const std::vector<std::string> &paths,
+             const check_fn<utils::representation::fitted_frozen_buchi> &fn = {},
+             unsigned threads = 0, std::size_t window = 0, bool degeneralized = false) noexcept;
+
+} // namespace emptiness_check::batch
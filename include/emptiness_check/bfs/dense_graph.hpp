@@ -0,0 +1,45 @@
+#pragma once
+
+#include "automates/inv_buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+#include "bfs/direction.hpp"
+
+namespace emptiness_check::bfs
+{
+
+/// \struct Reachable part of the automaton in the dense numbering with both transition directions
+/// \param State: state type of the automaton
+template<typename State>
+struct dense_graph
+{
+    /// \brief original state for each dense index. Index 0 is the initial state
+    std::vector<State> states;
+    /// \brief forward transitions (dense indexes)
+    direction::adjacency succs;
+    /// \brief backward (inverse) transitions restricted to the reachable states (dense indexes)
+    direction::adjacency preds;
+
+    /// \brief Bytes of the graph
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return automates::memory::vector_bytes(states) + succs.bytes() + preds.bytes();
+    }
+};
+
+/// \brief Collect states reachable from the initial state (forward BFS) with their transitions in both directions
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \param[out] index_bytes: bytes of the temporary dense index
+/// \return dense reachable graph
+template<typename State>
+dense_graph<State> build_dense_graph(const automates::basic_inv_buchi<State> &automat,
+                                     std::size_t &index_bytes) noexcept;
+
+/// \overload The dense index is the plain array over the state numbers. Backward rows are the transposition of the
+///     forward ones: no inverse table is needed
+template<typename State>
+dense_graph<State> build_dense_graph(const automates::basic_frozen_buchi<State> &automat,
+                                     std::size_t &index_bytes) noexcept;
+
+} // namespace emptiness_check::bfs
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "parallel/pool.hpp"
+#include "parallel/atomic_bitset.hpp"
+
+#include <vector>
+
+/// \brief Direction-optimizing (top-down/bottom-up) reachability over the dense graphs
+namespace emptiness_check::bfs::direction
+{
+
+/// \struct Dense adjacency in the CSR form
+struct adjacency
+{
+    /// \brief row offsets: neighbours of v are @targets[@offsets[v], @offsets[v + 1])
+    std::vector<std::size_t> offsets = { 0 };
+    /// \brief neighbours of all states row by row
+    std::vector<std::size_t> targets = {};
+
+    /// \brief Number of the neighbours
+    /// \param v: dense state
+    /// \return row length
+    [[nodiscard]] std::size_t degree(const std::size_t v) const noexcept { return offsets[v + 1] - offsets[v]; }
+
+    /// \brief Bytes of the rows
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept;
+};
+
+/// \class Reusable level-synchronous search that switches between the directions (Beamer's BFS)
+/// \details Top-down levels push the sparse frontier along its @push rows. Once the frontier rows outweigh the rows
+///     of the unreached states, bottom-up levels let every unreached state pull along its @pull rows until the
+///     first neighbour in the frontier bitmap. Small frontiers switch the search back to top-down
+/// \note @pull must be the transposition of @push
+class engine
+{
+public:
+    /// \brief Create buffers for the states and workers
+    /// \param states_num: number of the dense states
+    /// \param workers_num: number of the workers
+    engine(std::size_t states_num, unsigned workers_num) noexcept;
+
+    /// \brief Mark states of @allowed that reach @sources (in one or more @push steps inside @allowed)
+    /// \note Sources are marked only if they are reached themselves (cycle)
+    /// \param push: top-down rows
+    /// \param pull: bottom-up rows (transposition of @push)
+    /// \param allowed: states the search may visit (non-zero)
+    /// \param sources: the search starts from
+    /// \param workers: thread pool
+    /// \param colors: optional partition of the states. Steps never leave the class (color) of the state, so
+    ///     the sources of the different classes are searched independently in the same run
+    void run(const adjacency &push, const adjacency &pull, const std::vector<char> &allowed,
+             const std::vector<std::size_t> &sources, parallel::pool &workers,
+             const std::vector<std::size_t> *colors = nullptr) noexcept;
+
+    /// \brief Check the state after the last @run
+    /// \param v: dense state
+    /// \return true if the state was reached
+    [[nodiscard]] bool reached(const std::size_t v) const noexcept { return m_reach.test(v); }
+
+    /// \brief Number of the inspected rows entries by all runs
+    /// \return edges inspections
+    [[nodiscard]] std::size_t inspected_edges() const noexcept { return m_inspected; }
+
+    /// \brief Number of the rows entries the plain top-down search would inspect in the same runs
+    /// \note Sum of the @push rows lengths of the sources and of the reached states
+    /// \return edges inspections without the direction switching
+    [[nodiscard]] std::size_t top_down_edges() const noexcept { return m_top_down; }
+
+    /// \brief Bytes of the buffers
+    /// \note Storage is never shrunk: peak bytes
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept;
+
+private:
+    /// \struct Per-worker output of the level
+    struct alignas(64) worker_output
+    {
+        /// \brief newly reached states (top-down level)
+        std::vector<std::size_t> found = {};
+        /// \brief number of the newly reached states
+        std::size_t found_num = 0;
+        /// \brief sum of the @push rows lengths of the newly reached states
+        std::size_t found_degree = 0;
+        /// \brief sum of the @pull rows lengths of the newly reached states
+        std::size_t found_pull_degree = 0;
+        /// \brief inspected rows entries
+        std::size_t inspected = 0;
+    };
+
+    /// \brief Expand the sparse frontier along @push rows into the per-worker outputs
+    void top_down(const adjacency &push, const adjacency &pull, const std::vector<char> &allowed,
+                  parallel::pool &workers, const std::vector<std::size_t> *colors) noexcept;
+    /// \brief Let the unreached states pull along @pull rows from the frontier bitmap into the next bitmap
+    void bottom_up(const adjacency &push, const adjacency &pull, const std::vector<char> &allowed,
+                   parallel::pool &workers, const std::vector<std::size_t> *colors) noexcept;
+
+    /// \brief states reached by the current search
+    parallel::atomic_bitset m_reach;
+    /// \brief frontier of the bottom-up level
+    parallel::atomic_bitset m_frontier_bits;
+    /// \brief output of the bottom-up level
+    parallel::atomic_bitset m_next_bits;
+    /// \brief frontier of the top-down level
+    std::vector<std::size_t> m_frontier = {};
+    /// \brief per-worker output of the level
+    std::vector<worker_output> m_outputs;
+    /// \brief number of the states
+    std::size_t m_states_num;
+    /// \brief inspected rows entries by all runs
+    std::size_t m_inspected = 0;
+    /// \brief rows entries of the plain top-down search by all runs
+    std::size_t m_top_down = 0;
+};
+
+} // namespace emptiness_check::bfs::direction
@@ -1,10 +1,40 @@
 #pragma once
 
 #include "automates/inv_buchi.hpp"
+#include "automates/frozen_buchi.hpp"
 
 namespace emptiness_check::bfs::emerson
 {
 
-bool is_empty(const automates::inv_buchi &automat) noexcept;
+/// \struct Work of the backward searches
+struct edges_report
+{
+    /// \brief rows entries inspected by the direction-optimizing searches
+    std::size_t inspected = 0;
+    /// \brief rows entries the plain top-down searches would inspect
+    std::size_t top_down = 0;
+};
+
+/// \brief Look for the accepting lasso in NBA/NGA automaton with the Emerson–Lei nested fixpoint
+/// \details Set-based (breadth-first) algorithm: Z = νZ. ∩i pre+(Z ∩ Fi). Starting from all reachable states,
+///     the states that cannot reach every final set through a path inside Z are repeatedly pruned with the backward
+///     (inverse transitions) searches. The automaton is nonempty iff the fixpoint is nonempty
+/// \note Generalized acceptance is handled natively: one backward search per final set and round.
+///     Each level of the backward searches is expanded by all @threads (frontier-parallel). The searches switch
+///     between pushing along the inverse transitions and pulling along the forward ones (direction-optimizing)
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures (if requested)
+/// \param threads: number of the worker threads. 0 means all hardware threads
+/// \param[out] edges: inspected edges of all backward searches (if requested)
+/// \return false if it finds at least one (first) lasso
+template<typename State>
+bool is_empty(const automates::basic_inv_buchi<State> &automat, std::size_t *scratch_peak = nullptr,
+              unsigned threads = 1, edges_report *edges = nullptr) noexcept;
+
+/// \overload Backward searches run over the transposition of the frozen (CSR) table
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak = nullptr,
+              unsigned threads = 1, edges_report *edges = nullptr) noexcept;
 
 } // namespace emptiness_check::bfs::emerson
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+
+/// \brief The cooperative multi-core nested-DFS algorithm (CNDFS)
+namespace emptiness_check::dfs::cndfs
+{
+
+/// \brief Look for the accepting lasso in NBA automaton with the cooperating nested-DFS workers. Will assert on NGA
+/// \details Every worker runs the nested DFS in its own random successors order. The blue (explored) and red
+///     (checked by the second search) colors are shared through the atomic state-indexed bit arrays, so the workers
+///     prune each other's searches. Cyan (on the own blue path) and pink (on the own red search) colors are local.
+///     Before the states of the finished red search turn red, the worker waits for the other accepting states met
+///     there to be made red by their own workers. The worker with the lasso cancels the others, while the emptiness
+///     is proven only when all workers finish
+/// \note Linear-time in practice: the shared colors keep the total work close to the single nested DFS
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton. All its states are below the states bound
+/// \param[out] scratch_peak: peak bytes of the shared colors and all workers (if requested)
+/// \param threads: number of the workers. 0 means all hardware threads
+/// \return false if it finds at least one (first) lasso
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak = nullptr,
+              unsigned threads = 0) noexcept;
+
+/// \overload States are compacted (renumbered in DFS order) and frozen first, so any sparse numbers are accepted
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr,
+              unsigned threads = 0) noexcept;
+
+} // namespace emptiness_check::dfs::cndfs
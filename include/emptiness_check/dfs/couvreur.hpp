@@ -0,0 +1,27 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+
+/// \brief Couvreur's on-the-fly SCC-based algorithm
+namespace emptiness_check::dfs::couvreur
+{
+
+/// \brief Look for the accepting lasso in NBA/NGA automaton
+/// \details Every discovered state becomes the root of its own SCC on the roots stack. An edge back to a live state
+/// unites all SCCs above that state's SCC into one (the roots stack is popped to the lowest root) and merges their
+/// indexes sets. The search stops as soon as the united SCC covers all K final sets. When the root is fully
+/// expanded, its SCC is complete: the states are popped from the live stack and marked dead
+/// \note NBA is the case K = 1, so no degeneralization (nga2nba) is needed
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures (if requested)
+/// \return false if it finds at least one (first) lasso
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \overload Lookup-free traversal of the frozen (CSR) transition table
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+} // namespace emptiness_check::dfs::couvreur
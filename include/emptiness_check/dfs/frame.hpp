@@ -0,0 +1,190 @@
+#pragma once
+
+#include "automates/memory.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace emptiness_check::dfs
+{
+
+/// \struct Frame of the explicit (heap-allocated) DFS stack: expanded state with its not yet visited successors
+/// \note Replaces the call stack frame of the recursive search. Successor ranges of the automaton are stable
+///     (read-only tables), so the iterators stay valid while the frame is on the stack
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+struct frame
+{
+    /// \typedef Iterator over the successors range of the automaton
+    using iterator = decltype(std::begin(std::declval<typename Automaton::successors_range>()));
+
+    /// \brief Start expansion of the state
+    /// \param q: expanded state
+    /// \param automat: investigated automaton
+    frame(const typename Automaton::atm_size q, const Automaton &automat) noexcept
+        : state(q)
+    {
+        auto&& range = automat.successors(q);
+        next = std::begin(range);
+        end = std::end(range);
+    }
+
+    /// \brief Check if all successors were visited
+    /// \return true if the state is fully expanded
+    [[nodiscard]] bool expanded() const noexcept { return next == end; }
+
+    /// \brief expanded state
+    typename Automaton::atm_size state;
+    /// \brief next successor to visit
+    iterator next;
+    /// \brief end of the successors
+    iterator end;
+};
+
+/// \class Successors are visited in the transition table order
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+class table_order
+{
+public:
+    /// \typedef Frame of the explicit DFS stack
+    using frame_type = frame<Automaton>;
+
+    /// \brief Start expansion of the state
+    /// \param q: expanded state
+    /// \param automat: investigated automaton
+    /// \return new frame
+    frame_type open(const typename Automaton::atm_size q, const Automaton &automat) noexcept { return {q, automat}; }
+
+    /// \brief Take the next successor of the frame
+    /// \param f: not expanded frame
+    /// \return successor state
+    typename Automaton::atm_size next(frame_type &f) noexcept { return *f.next++; }
+
+    /// \brief Finish expansion of the frame
+    void close(const frame_type&) noexcept {}
+
+    /// \brief Bytes of the order buffers
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept { return 0; }
+};
+
+/// \class Successors of all frames lie in the shared buffer (stack order). Base of the orders that copy or
+///     generate the successors on expansion
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+class buffered_order
+{
+public:
+    /// \struct Frame of the explicit DFS stack: successors lie in the shared buffer
+    struct frame_type
+    {
+        /// \brief Check if all successors were visited
+        /// \return true if the state is fully expanded
+        [[nodiscard]] bool expanded() const noexcept { return next == end; }
+
+        /// \brief expanded state
+        typename Automaton::atm_size state;
+        /// \brief first successor of the frame in the buffer
+        std::size_t begin;
+        /// \brief next successor to visit
+        std::size_t next;
+        /// \brief end of the successors in the buffer
+        std::size_t end;
+    };
+
+    /// \brief Take the next successor of the frame
+    /// \param f: not expanded frame
+    /// \return successor state
+    typename Automaton::atm_size next(frame_type &f) noexcept { return m_successors[f.next++]; }
+
+    /// \brief Finish expansion of the frame
+    /// \note Frames are finished in the stack order: the top of the buffer belongs to @f
+    /// \param f: the top frame
+    void close(const frame_type &f) noexcept { m_successors.resize(f.begin); }
+
+    /// \brief Bytes of the order buffers
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept { return automates::memory::vector_bytes(m_successors); }
+
+protected:
+    /// \brief successors of all frames on the stacks
+    std::vector<typename Automaton::atm_size> m_successors = {};
+};
+
+/// \class Successors are visited in the seeded random permutation (one per swarm worker)
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+class random_order : public buffered_order<Automaton>
+{
+public:
+    /// \typedef Frame of the explicit DFS stack
+    using frame_type = typename buffered_order<Automaton>::frame_type;
+
+    /// \brief Create the permutation source
+    /// \param seed: worker seed
+    explicit random_order(const std::size_t seed) noexcept : m_rng(seed) {}
+
+    /// \brief Start expansion of the state: copy and shuffle its successors on top of the buffer
+    /// \param q: expanded state
+    /// \param automat: investigated automaton
+    /// \return new frame
+    frame_type open(const typename Automaton::atm_size q, const Automaton &automat) noexcept
+    {
+        auto& buffer = this->m_successors;
+        const auto begin = buffer.size();
+        for (const auto& qt : automat.successors(q))
+            buffer.push_back(qt);
+        std::shuffle(buffer.begin() + static_cast<std::ptrdiff_t>(begin), buffer.end(), m_rng);
+
+        return { .state = q, .begin = begin, .next = begin, .end = buffer.size() };
+    }
+
+private:
+    /// \brief worker permutations source
+    std::mt19937_64 m_rng;
+};
+
+/// \class Successors are generated on expansion (implicit automata): visited in the generation order
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+class generated_order : public buffered_order<Automaton>
+{
+public:
+    /// \typedef Frame of the explicit DFS stack
+    using frame_type = typename buffered_order<Automaton>::frame_type;
+
+    /// \brief Start expansion of the state: generate its successors on top of the buffer
+    /// \param q: expanded state
+    /// \param automat: investigated automaton
+    /// \return new frame
+    frame_type open(const typename Automaton::atm_size q, const Automaton &automat) noexcept
+    {
+        auto& buffer = this->m_successors;
+        const auto begin = buffer.size();
+        automat.successors(q, buffer);
+
+        return { .state = q, .begin = begin, .next = begin, .end = buffer.size() };
+    }
+};
+
+/// \brief Check if the automaton generates the successors into the buffer (implicit automaton)
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+concept generating = requires(const Automaton &automat, typename Automaton::atm_size q,
+                              std::vector<typename Automaton::atm_size> &out)
+{
+    automat.successors(q, out);
+};
+
+/// \typedef Order of the plain (non-swarm) searches: stored tables are traversed in place, implicit automata
+///     generate the successors on expansion
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+using search_order = std::conditional_t<generating<Automaton>, generated_order<Automaton>, table_order<Automaton>>;
+
+} // namespace emptiness_check::dfs
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+
+#include <span>
+
+/// \brief Emptiness check maintained under the transitions insertions
+namespace emptiness_check::dfs::incremental
+{
+
+/// \class Incremental emptiness check: SCCs with their acceptance are kept while the transitions are added
+/// \details Insertions only merge SCCs and only extend the reachable part, so the answer changes at most once
+///     (from empty to nonempty). The SCCs of all known states are kept in the union-find with the merged indexes sets
+///     and in the topological order of the condensation (Pearce–Kelly). The transition that goes against the order
+///     searches only the SCCs between its ends in the order: forward from the target and backward from the source.
+///     The SCCs on the found cycle merge into one, the rest of the region is reordered. The transition from the
+///     reachable state to the unreachable one marks only the newly reachable states
+/// \note The final sets are fixed by the construction. New states of the transitions are not final unless they
+///     are in the final sets of the source automaton
+/// \param State: state type of the automaton
+template<typename State>
+class checker
+{
+public:
+    /// \typedef One transition: <from, to>
+    using edge = std::pair<State, State>;
+
+    /// \brief Decompose the automaton into SCCs (Tarjan) and find the reachable states
+    /// \param automat: initial automaton
+    explicit checker(const automates::basic_buchi<State> &automat) noexcept;
+
+    /// \overload
+    explicit checker(const automates::basic_frozen_buchi<State> &automat) noexcept;
+
+    /// \brief Add the transition and update the answer
+    /// \param from: source state
+    /// \param to: target state
+    /// \return false if the automaton has an accepting lasso
+    bool add_edge(State from, State to) noexcept;
+
+    /// \brief Add the batch of the transitions and update the answer
+    /// \param batch: transitions in any order. Duplicates are allowed
+    /// \return false if the automaton has an accepting lasso
+    bool add_edges(std::span<const edge> batch) noexcept;
+
+    /// \brief Current answer
+    /// \return false if the automaton has an accepting lasso
+    [[nodiscard]] bool is_empty() const noexcept { return !m_nonempty; }
+
+    /// \brief Number of the SCCs of the known states
+    /// \return components number
+    [[nodiscard]] std::size_t components_num() const noexcept { return m_components_num; }
+
+    /// \brief Number of the known states
+    /// \return states number
+    [[nodiscard]] std::size_t states_num() const noexcept { return m_successors.size(); }
+
+    /// \brief Number of the SCCs and states visited by the updates of the last add_edge(s) call
+    /// \return size of the affected region
+    [[nodiscard]] std::size_t touched() const noexcept { return m_touched; }
+
+    /// \brief Bytes of the maintained structures
+    /// \return estimated bytes
+    [[nodiscard]] std::size_t bytes() const noexcept;
+
+private:
+    /// \brief Dense number of the state. Unknown state becomes a new trivial SCC
+    /// \param q: automaton state
+    /// \return dense state
+    std::size_t intern(State q) noexcept;
+
+    /// \brief Add the transition and update the SCCs, reachability and the answer
+    /// \param from: source state
+    /// \param to: target state
+    void insert(State from, State to) noexcept;
+
+    /// \brief Decompose the known states into SCCs and set their topological order
+    void decompose() noexcept;
+
+    /// \brief Mark the states reachable from @v
+    /// \param v: newly reached dense state
+    void reach(std::size_t v) noexcept;
+
+    /// \brief Restore the topological order after the transition u -> v and merge the closed cycle
+    /// \param u: dense source state
+    /// \param v: dense target state
+    void update_order(std::size_t u, std::size_t v) noexcept;
+
+    /// \brief SCC of the state
+    /// \param v: dense state
+    /// \return representative dense state
+    std::size_t find(std::size_t v) noexcept;
+
+    /// \brief Merge the SCCs into one
+    /// \param components: representatives
+    /// \return representative of the merged SCC
+    std::size_t unite(const std::vector<std::size_t> &components) noexcept;
+
+    /// \brief Check the SCC and remember the lasso
+    /// \param c: representative
+    void check(std::size_t c) noexcept;
+
+    /// \brief Packed indexes set of the SCC
+    /// \param c: representative
+    /// \return @m_width words
+    std::span<automates::mask::word> marks(const std::size_t c) noexcept
+    {
+        return { m_marks.data() + c * m_width, m_width };
+    }
+
+    /// \brief final sets of the source automaton
+    typename automates::basic_buchi<State>::finals_container m_finals;
+    /// \brief number of the final sets
+    std::size_t m_sets_num;
+    /// \brief number of words per packed indexes set
+    std::size_t m_width;
+    /// \brief dense number of each known state
+    std::unordered_map<State, std::size_t> m_numbers = {};
+    /// \brief successors by the dense states
+    std::vector<std::vector<std::size_t>> m_successors = {};
+    /// \brief predecessors by the dense states
+    std::vector<std::vector<std::size_t>> m_predecessors = {};
+    /// \brief reachable from INITIAL_STATE flag by the dense states
+    std::vector<char> m_reached = {};
+    /// \brief union-find parent by the dense states
+    std::vector<std::size_t> m_parent = {};
+    /// \brief topological position of the SCC (by the representative): c -> d implies @m_order[c] < @m_order[d]
+    std::vector<std::size_t> m_order = {};
+    /// \brief states of the SCC (by the representative)
+    std::vector<std::vector<std::size_t>> m_members = {};
+    /// \brief SCC has a cycle (by the representative)
+    std::vector<char> m_cyclic = {};
+    /// \brief packed indexes sets of the SCCs (by the representative), @m_width words each
+    std::vector<automates::mask::word> m_marks = {};
+    /// \brief search stamps by the dense states: forward and backward marks of the current update
+    std::vector<std::size_t> m_forward = {}, m_backward = {};
+    /// \brief stamp of the current update
+    std::size_t m_stamp = 0;
+    /// \brief next free topological position
+    std::size_t m_next_order = 0;
+    /// \brief number of the SCCs
+    std::size_t m_components_num = 0;
+    /// \brief affected region of the last update
+    std::size_t m_touched = 0;
+    /// \brief reachable accepting SCC was found
+    bool m_nonempty = false;
+};
+
+} // namespace emptiness_check::dfs::incremental
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+namespace emptiness_check::dfs
+{
+
+/// \struct Accepting lasso (counterexample) found by the search
+/// \param State: state type of the automaton
+template<typename State>
+struct lasso
+{
+    /// \brief path from the initial state to the first state of the cycle (excluded). Empty if the cycle passes
+    ///     through the initial state
+    std::vector<State> stem = {};
+    /// \brief accepting cycle in the transitions order: the last state has the transition to the first one
+    std::vector<State> cycle = {};
+};
+
+} // namespace emptiness_check::dfs
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+#include "automates/implicit_buchi.hpp"
+#include "dfs/lasso.hpp"
+
+#include <optional>
 
 /// \brief The nested-DFS algorithm
 namespace emptiness_check::dfs::nested
@@ -12,8 +17,71 @@ namespace emptiness_check::dfs::nested
 /// determined by the sorting.
 /// \note The algorithm, however, also has two important weak points:
 ///     It cannot be extended to NGAs, and it is not optimal
+/// \note Both searches run on the explicit heap-allocated frame stacks: depth is limited by memory only
+/// \param State: state type of the automaton
 /// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures (if requested)
 /// \return false if it finds at least one (first) lasso
-bool is_empty(const automates::buchi &automat) noexcept;
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \overload Lookup-free traversal of the frozen (CSR) transition table
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \overload On-the-fly search: states are generated only when they are expanded, the search stops at the first lasso
+template<typename State>
+bool is_empty(const automates::basic_implicit_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \brief Same search as @is_empty that returns the lasso found
+/// \details The lasso is rebuilt from the stacks at the moment the second search reaches the path of the first one:
+///     the path (P) up to the reached state is the stem, the rest of the path with the second search stack is the cycle
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \return the first lasso or nullopt for the empty automaton
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_buchi<State> &automat) noexcept;
+
+/// \overload Lookup-free traversal of the frozen (CSR) transition table
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_frozen_buchi<State> &automat) noexcept;
+
+/// \overload On-the-fly search: states are generated only when they are expanded
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_implicit_buchi<State> &automat) noexcept;
+
+/// \brief Same search as @is_empty with the visiting info packed into the bit array: 3 bits per state
+///     (two search phases and the path bit). No hashing in the inner loop
+/// \note States are compacted (renumbered in DFS order) and frozen first, so any sparse numbers are accepted
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures with the compacted copy (if requested)
+/// \return false if it finds at least one (first) lasso
+template<typename State>
+bool is_empty_packed(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \overload Frozen table is already indexed by the state numbers: the bit array covers the states bound
+template<typename State>
+bool is_empty_packed(const automates::basic_frozen_buchi<State> &automat,
+                     std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \brief Swarm of the independent Nested-DFS workers: each one has its own visiting info and its own seeded
+///     random permutation of the successors. The first worker that finds the lasso (or explores the whole state
+///     space) cancels the others
+/// \note Sharply cuts the time to the counterexample on the nonempty automata. Empty automata are fully explored by
+///     every worker (no work sharing)
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: sum of the peak bytes of all workers (if requested)
+/// \param threads: number of the workers. 0 means all hardware threads
+/// \return false if it finds at least one (first) lasso
+template<typename State>
+bool is_empty_swarm(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr,
+                    unsigned threads = 0) noexcept;
+
+/// \overload Frozen table: the workers keep the visiting info in the packed bit arrays
+template<typename State>
+bool is_empty_swarm(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak = nullptr,
+                    unsigned threads = 0) noexcept;
 
 } // namespace emptiness_check::dfs::nested
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+
+#include <optional>
+#include <span>
+#include <vector>
+
+/// \brief Tarjan's SCC decomposition with the acceptance summary of every SCC
+namespace emptiness_check::dfs::tarjan
+{
+
+/// \class Compact table of the SCCs reachable from the initial state
+/// \details The table is built once by the iterative Tarjan's search. Emptiness questions (for all final sets or for
+///     any subset of them) are answered from the table in O(#SCC) without the new search
+/// \param State: state type of the automaton
+template<typename State>
+class scc_table
+{
+public:
+    /// \brief Decompose the reachable part of the automaton
+    /// \param automat: investigated automaton
+    /// \param[out] scratch_peak: peak bytes of the search structures (if requested). The table is not included
+    explicit scc_table(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+    /// \overload Lookup-free traversal of the frozen (CSR) transition table
+    explicit scc_table(const automates::basic_frozen_buchi<State> &automat,
+                       std::size_t *scratch_peak = nullptr) noexcept;
+
+    /// \brief Number of the reachable SCCs
+    /// \return number of the components
+    [[nodiscard]] std::size_t components_num() const noexcept { return m_sizes.size(); }
+
+    /// \brief Component of the state
+    /// \note Components are numbered in the completion order: successors SCCs have smaller ids (reverse topological)
+    /// \param q: automaton state
+    /// \return component id or nullopt for the unreachable state
+    [[nodiscard]] std::optional<std::size_t> component(State q) const noexcept;
+
+    /// \brief Number of the states in the component
+    /// \param c: component id
+    /// \return size of the SCC
+    [[nodiscard]] std::size_t size(const std::size_t c) const noexcept { return m_sizes[c]; }
+
+    /// \brief Check if the component has no cycle: a single state without the self-loop
+    /// \param c: component id
+    /// \return true for the trivial SCC
+    [[nodiscard]] bool is_trivial(const std::size_t c) const noexcept { return m_trivial[c]; }
+
+    /// \brief Final sets met by the states of the component
+    /// \param c: component id
+    /// \return packed indexes set (see automates::mask)
+    [[nodiscard]] std::span<const automates::mask::word> marks(const std::size_t c) const noexcept
+    {
+        return { m_marks.data() + c * m_width, m_width };
+    }
+
+    /// \brief Check if the component is the accepting one for the selected final sets
+    /// \param c: component id
+    /// \param required: packed indexes set of the selected final sets
+    /// \return true if the SCC is non-trivial and meets all selected sets
+    [[nodiscard]] bool is_accepting(std::size_t c, std::span<const automates::mask::word> required) const noexcept;
+
+    /// \brief Check the emptiness for all final sets
+    /// \return true if no accepting SCC is reachable
+    [[nodiscard]] bool is_empty() const noexcept;
+
+    /// \brief Check the emptiness for the subset of the final sets
+    /// \param sets: indexes of the selected final sets
+    /// \return true if no SCC is accepting for the selected sets
+    [[nodiscard]] bool is_empty(const std::vector<std::size_t> &sets) const noexcept;
+
+    /// \brief Bytes of the table
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept;
+
+private:
+    /// \brief Build the table by the iterative Tarjan's search
+    /// \param Automaton: investigated automaton representation
+    /// \param automat: investigated automaton
+    /// \return peak bytes of the search structures
+    template<typename Automaton>
+    std::size_t decompose(const Automaton &automat) noexcept;
+
+    /// \brief words in each packed indexes set
+    std::size_t m_width;
+    /// \brief number of the final sets
+    std::size_t m_sets_num;
+    /// \brief DFS number of each reachable state
+    std::unordered_map<State, std::size_t> m_numbers = {};
+    /// \brief component id for each DFS number
+    std::vector<std::size_t> m_components = {};
+    /// \brief number of the states of each component
+    std::vector<std::size_t> m_sizes = {};
+    /// \brief trivial flag of each component
+    std::vector<char> m_trivial = {};
+    /// \brief packed indexes sets of the components one after another
+    std::vector<automates::mask::word> m_marks = {};
+};
+
+/// \brief Look for the accepting SCC in NBA/NGA automaton through the full decomposition
+/// \note Never stops early: the whole reachable part is decomposed. Reference for the on-the-fly algorithms
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures and the table (if requested)
+/// \return false if some reachable SCC is accepting
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \overload Lookup-free traversal of the frozen (CSR) transition table
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+} // namespace emptiness_check::dfs::tarjan
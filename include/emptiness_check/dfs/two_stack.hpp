@@ -1,6 +1,12 @@
 #pragma once
 
 #include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+#include "automates/implicit_buchi.hpp"
+#include "dfs/lasso.hpp"
+
+#include <memory_resource>
+#include <optional>
 
 /// \brief The two-stack algorithm
 namespace emptiness_check::dfs::two_stack
@@ -10,8 +16,61 @@ namespace emptiness_check::dfs::two_stack
 /// \details While the state is grey, the algorithm tries to find a cycle containing it. If it succeeds, then the state
 /// is removed from C. If not, then the state is removed from C when it is blackened. At any time t, the candidates are
 /// the currently grey states that do not belong to any cycle of At.
+/// \note The search runs on the explicit heap-allocated frame stack: depth is limited by memory only
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures (if requested)
+/// \return false if it finds at least one (first) lasso
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \overload Lookup-free traversal of the frozen (CSR) transition table
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \overload Search structures are allocated from @scratch
+/// \note The pool resource kept across many checks (e.g. one per batch worker) reuses the blocks of the previous
+///     searches instead of asking the heap again
+/// \param scratch: memory of the search structures. Must outlive the call
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak,
+              std::pmr::memory_resource *scratch) noexcept;
+
+/// \overload On-the-fly search: states are generated only when they are expanded, the search stops at the first lasso
+template<typename State>
+bool is_empty(const automates::basic_implicit_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \brief Same search as @is_empty that returns the lasso found
+/// \details The lasso is rebuilt at the moment of NONEMPTY notification: the DFS stack up to the source of the closing
+///     transition is the stem. The live states of V above the merged root form the closed SCC: the top ones that cover
+///     all final sets are linked into the cycle by the searches restricted to the live states (the stacks do not keep
+///     the paths inside the SCC)
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \return the first lasso or nullopt for the empty automaton
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_buchi<State> &automat) noexcept;
+
+/// \overload Lookup-free traversal of the frozen (CSR) transition table
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_frozen_buchi<State> &automat) noexcept;
+
+/// \overload On-the-fly search: states are generated only when they are expanded
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_implicit_buchi<State> &automat) noexcept;
+
+/// \brief Recursive version of @is_empty. Reference for the benchmarks
+/// \note Depth is limited by the call stack. Recursion frames are not included into @scratch_peak
+/// \param State: state type of the automaton
 /// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures (if requested)
 /// \return false if it finds at least one (first) lasso
-bool is_empty(const automates::buchi &automat) noexcept;
+template<typename State>
+bool is_empty_recursive(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak = nullptr) noexcept;
+
+/// \overload Lookup-free traversal of the frozen (CSR) transition table
+template<typename State>
+bool is_empty_recursive(const automates::basic_frozen_buchi<State> &automat,
+                        std::size_t *scratch_peak = nullptr) noexcept;
 
 } // namespace emptiness_check::dfs::two_stack
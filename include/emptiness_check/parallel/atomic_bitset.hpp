@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace emptiness_check::parallel
+{
+
+/// \class Fixed-size bit set with the lock-free concurrent membership updates
+class atomic_bitset
+{
+public:
+    /// \typedef Storage word
+    using word = uint64_t;
+
+    /// \brief Create set of the cleared bits
+    /// \param size: number of the bits
+    explicit atomic_bitset(const std::size_t size) noexcept : m_words((size + WORD_BITS - 1) / WORD_BITS) {}
+
+    /// \brief Check the bit
+    /// \param i: bit index
+    /// \return true if the bit is set
+    [[nodiscard]] bool test(const std::size_t i) const noexcept
+    {
+        return m_words[i / WORD_BITS].load(std::memory_order_relaxed) & bit(i);
+    }
+
+    /// \brief Set the bit
+    /// \note Exactly one of the concurrent callers for the same bit gets true
+    /// \param i: bit index
+    /// \return true if the bit was cleared before the call
+    bool set(const std::size_t i) noexcept
+    {
+        auto &w = m_words[i / WORD_BITS];
+        // cheap check first: most of the repeated visits do not need the read-modify-write
+        return !(w.load(std::memory_order_relaxed) & bit(i)) &&
+               !(w.fetch_or(bit(i), std::memory_order_relaxed) & bit(i));
+    }
+
+    /// \brief Clear all bits
+    /// \note Not synchronized with the concurrent updates
+    void clear() noexcept
+    {
+        for (auto &w : m_words)
+            w.store(0, std::memory_order_relaxed);
+    }
+
+    /// \brief Bytes of the storage
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept { return m_words.capacity() * sizeof(word); }
+
+private:
+    /// \brief bits in one storage word
+    static constexpr std::size_t WORD_BITS = 64;
+
+    /// \brief Mask of the bit in its word
+    /// \param i: bit index
+    /// \return word with the one set bit
+    static word bit(const std::size_t i) noexcept { return word{1} << (i % WORD_BITS); }
+
+    /// \brief bits storage
+    std::vector<std::atomic<word>> m_words;
+};
+
+} // namespace emptiness_check::parallel
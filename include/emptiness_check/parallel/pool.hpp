@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief Shared-memory parallelism helpers for the emptiness algorithms
+namespace emptiness_check::parallel
+{
+
+/// \class Fixed set of the persistent worker threads. The calling thread takes part in every run as worker 0
+/// \note Workers sleep between the runs, so frequent short runs (e.g. one per BFS level) are cheap
+class pool
+{
+public:
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+
+    /// \brief Start the workers
+    /// \param threads: total number of the workers including the calling thread. 0 means all hardware threads
+    explicit pool(unsigned threads = 0) noexcept;
+
+    /// \brief Stop and join the workers
+    ~pool() noexcept;
+
+    /// \brief Number of the workers including the calling thread
+    /// \return workers number
+    [[nodiscard]] unsigned size() const noexcept { return static_cast<unsigned>(m_workers.size()) + 1; }
+
+    /// \brief Run the task on every worker and wait for all of them
+    /// \param task: callback with the worker index [0, size())
+    void run(const std::function<void(unsigned)> &task) noexcept;
+
+private:
+    /// \brief Worker loop: wait for the next run or stop
+    /// \param id: worker index
+    void work(unsigned id) noexcept;
+
+    /// \brief worker threads (without the calling one)
+    std::vector<std::thread> m_workers = {};
+    /// \brief guards the run state below
+    std::mutex m_mutex;
+    /// \brief notifies the workers about a new run or stop
+    std::condition_variable m_start;
+    /// \brief notifies the caller about finished workers
+    std::condition_variable m_done;
+    /// \brief task of the current run
+    const std::function<void(unsigned)> *m_task = nullptr;
+    /// \brief number of the started runs
+    std::size_t m_generation = 0;
+    /// \brief workers that have not finished the current run
+    unsigned m_pending = 0;
+    /// \brief workers must exit
+    bool m_stop = false;
+};
+
+/// \brief Split [0, @size) into the chunks and process them on all workers with dynamic balancing
+/// \param workers: thread pool
+/// \param size: number of the items
+/// \param chunk: number of the items taken at once
+/// \param fn: callback (begin, end, worker index) for each chunk
+template<typename F>
+void for_each_chunk(pool &workers, const std::size_t size, const std::size_t chunk, F &&fn) noexcept
+{
+    if (workers.size() == 1 || size <= chunk)
+    {
+        if (size)
+            fn(std::size_t{0}, size, 0u);
+        return;
+    }
+
+    std::atomic<std::size_t> cursor = 0;
+    workers.run([&cursor, size, chunk, &fn](const unsigned id)
+    {
+        for (std::size_t begin = cursor.fetch_add(chunk); begin < size; begin = cursor.fetch_add(chunk))
+            fn(begin, std::min(begin + chunk, size), id);
+    });
+}
+
+/// \brief Process every item of [0, @size) on all workers with the work stealing
+/// \details Every worker owns the contiguous part of the items and takes them one by one from its front. The worker
+///     without own items steals the back half of the next not empty part. Suits the items of the unequal cost
+/// \param workers: thread pool
+/// \param size: number of the items
+/// \param fn: callback (item, worker index) for each item
+template<typename F>
+void for_each_stealing(pool &workers, const std::size_t size, F &&fn) noexcept
+{
+    if (workers.size() == 1 || size <= 1)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            fn(i, 0u);
+        return;
+    }
+
+    /// \struct Not yet processed items of the worker
+    struct alignas(64) part
+    {
+        /// \brief guards the range
+        std::mutex lock;
+        /// \brief first not taken item
+        std::size_t begin = 0;
+        /// \brief end of the range
+        std::size_t end = 0;
+    };
+
+    const std::size_t n = workers.size();
+    std::vector<part> parts(n);
+    for (std::size_t w = 0; w < n; ++w)
+    {
+        parts[w].begin = size * w / n;
+        parts[w].end = size * (w + 1) / n;
+    }
+
+    workers.run([&parts, n, &fn](const unsigned id)
+    {
+        auto& own = parts[id];
+        while (true)
+        {
+            std::size_t item = 0;
+            bool taken = false;
+            {
+                std::scoped_lock guard(own.lock);
+                if (own.begin < own.end)
+                {
+                    item = own.begin++;
+                    taken = true;
+                }
+            }
+            if (taken)
+            {
+                fn(item, id);
+                continue;
+            }
+
+            // steal the back half of the victim range
+            std::size_t begin = 0, end = 0;
+            for (std::size_t k = 1; k < n && begin == end; ++k)
+            {
+                auto& victim = parts[(id + k) % n];
+                std::scoped_lock guard(victim.lock);
+                end = victim.end;
+                begin = victim.end - (victim.end - victim.begin) / 2;
+                // the last item is taken as is
+                if (begin == end && victim.begin < victim.end)
+                    --begin;
+                victim.end = begin;
+            }
+            // the stolen items may only be processed by the thief: all others are done or taken
+            if (begin == end)
+                break;
+
+            /// \note the victim lock is released first: two thieves never wait for each other
+            std::scoped_lock guard(own.lock);
+            own.begin = begin;
+            own.end = end;
+        }
+    });
+}
+
+} // namespace emptiness_check::parallel
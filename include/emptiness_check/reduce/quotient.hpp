@@ -0,0 +1,29 @@
+#pragma once
+
+#include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+
+/// \brief Language-preserving reductions of the automata before the emptiness checks
+namespace emptiness_check::reduce
+{
+
+/// \brief Merge the bisimilar states: quotient by the coarsest direct bisimulation that respects acceptance
+/// \details Partition refinement by signatures. The initial partition groups the states with the same final sets
+///     indexes. Every round the signature of the state is its block with the sorted blocks of its successors, and
+///     the states with equal signatures form the new blocks. The signatures are built by the pool of the workers;
+///     the blocks are numbered in one serial pass. Rounds stop once no block splits. The quotient has the block
+///     transitions and acceptance, so its language (and emptiness) is the same
+/// \note The block of INITIAL_STATE is 0. States are the transitions ends, the initial and the final states
+/// \param State: state type of the automaton
+/// \param automat: reduced automaton
+/// \param threads: number of the workers (including the calling thread). 0 means all hardware threads
+/// \return quotient automaton (the construction mode of @automat is kept)
+template<typename State>
+automates::basic_buchi<State> quotient(const automates::basic_buchi<State> &automat, unsigned threads = 0) noexcept;
+
+/// \overload
+template<typename State>
+automates::basic_frozen_buchi<State> quotient(const automates::basic_frozen_buchi<State> &automat,
+                                              unsigned threads = 0) noexcept;
+
+} // namespace emptiness_check::reduce
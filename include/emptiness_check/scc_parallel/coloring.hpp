@@ -0,0 +1,31 @@
+#pragma once
+
+#include "automates/inv_buchi.hpp"
+#include "automates/frozen_buchi.hpp"
+
+/// \brief Emptiness checks based on the parallel decomposition into the strongly connected components
+namespace emptiness_check::scc_parallel
+{
+
+/// \brief Look for the accepting lasso in NBA/NGA automaton with the parallel SCC decomposition by coloring
+/// \details The reachable states are split into the classes. Every round all classes are processed at once:
+///     states without a predecessor or a successor in their class are trimmed, the maximal state number is
+///     propagated forward inside each class (coloring), and every state that keeps its own number (root) collects
+///     its SCC with the backward search among the states of its color. The rest of each color is the new class.
+///     The automaton is nonempty iff some non-trivial SCC intersects every final set
+/// \note Generalized acceptance is handled natively: no conversion to NBA
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures (if requested)
+/// \param threads: number of the worker threads. 0 means all hardware threads
+/// \return false if it finds at least one (first) accepting SCC
+template<typename State>
+bool is_empty(const automates::basic_inv_buchi<State> &automat, std::size_t *scratch_peak = nullptr,
+              unsigned threads = 0) noexcept;
+
+/// \overload Backward searches run over the transposition of the frozen (CSR) table
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak = nullptr,
+              unsigned threads = 0) noexcept;
+
+} // namespace emptiness_check::scc_parallel
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "automates/inv_buchi.hpp"
+#include "automates/frozen_buchi.hpp"
 
 #include <chrono>
 #include <functional>
@@ -18,28 +19,56 @@ struct callbacks_handler
 {
     /// \brief generation function
     std::function<T()> generation_fn;
+    /// \brief optional reduction function (runs before the conversion). Its result replaces the generated automaton
+    std::function<std::optional<T>(const T &)> reduce_fn = {};
     /// \brief conversion function
     std::function<std::optional<T>(const T &)> conv_fn;
-    /// \brief container of a serial NBA algorithms functions
-    std::vector<std::function<bool(const T &)>> nba_algorithms;
-    /// \brief container of a serial NGA algorithms functions
-    std::vector<std::function<bool(const T &)>> nga_algorithms;
+    /// \brief container of a serial NBA algorithms functions. Second argument receives peak scratch bytes
+    std::vector<std::function<bool(const T &, std::size_t *)>> nba_algorithms;
+    /// \brief container of a serial NGA algorithms functions. Second argument receives peak scratch bytes
+    std::vector<std::function<bool(const T &, std::size_t *)>> nga_algorithms;
+    /// \brief optional untimed search over the checked automaton that reports its edges inspections:
+    ///     <inspected, inspected by the plain top-down search>
+    std::function<std::pair<std::size_t, std::size_t>(const T &)> edges_fn = {};
 };
 
 /// \struct Statistic report for the one similar data entry
 struct one_step
 {
     /// \brief Future automaton states number
-    automates::buchi::atm_size states = 0;
+    /// \note Independent of the generated automaton state type
+    uint64_t states = 0;
     /// \brief Collect average time for the called conversions
     call_durration average_conversion = {};
+    /// \brief Average time of the called reductions
+    call_durration average_reduction = call_durration::zero();
     /// \brief Average one automaton generation time
     call_durration average_generation = call_durration::zero();
+    /// \brief Average number of the allocations for the called conversions
+    /// \note Allocations through the default memory resource: nodes of the hashed tables (or the arena blocks)
+    std::size_t average_conversion_allocs = 0;
+    /// \brief Average number of the allocations (default memory resource) for one automaton generation
+    std::size_t average_generation_allocs = 0;
+    /// \brief Average footprint of the converted automata
+    automates::memory_report average_conversion_memory = {};
+    /// \brief Average footprint of the reduced automata
+    automates::memory_report average_reduction_memory = {};
+    /// \brief Average footprint of the generated automata
+    automates::memory_report average_generation_memory = {};
 
     /// \brief Collect algorithms answers positime (is_empty = true) with their average time calculation
     std::vector<std::pair<automates::buchi::atm_size, call_durration>> average_nba = {};
     /// \brief Collect algorithms answers positime (is_empty = true) with their average time calculation
     std::vector<std::pair<automates::buchi::atm_size, call_durration>> average_nga = {};
+    /// \brief Peak scratch bytes of each NBA algorithm among all runs
+    std::vector<std::size_t> peak_nba_scratch = {};
+    /// \brief Peak scratch bytes of each NGA algorithm among all runs
+    std::vector<std::size_t> peak_nga_scratch = {};
+
+    /// \brief Average edges inspections of @callbacks_handler::edges_fn
+    std::size_t average_inspected_edges = 0;
+    /// \brief Average edges inspections of the plain top-down search
+    std::size_t average_top_down_edges = 0;
 
     /// \brief Increases when NGA != NBA on emptiness
     automates::buchi::atm_size different_results = 0;
@@ -56,4 +85,16 @@ one_step one_step_generation(automates::buchi::atm_size repetition,
 one_step one_step_generation(automates::buchi::atm_size repetition,
                                  const callbacks_handler<automates::inv_buchi> &callbacks) noexcept;
 
+/// \note: due to need to hide template implementation
+one_step one_step_generation(automates::buchi::atm_size repetition,
+                                 const callbacks_handler<automates::frozen_buchi> &callbacks) noexcept;
+
+/// \note: due to need to hide template implementation. Automata with 64-bit states
+one_step one_step_generation(automates::buchi::atm_size repetition,
+                                 const callbacks_handler<automates::basic_inv_buchi<uint64_t>> &callbacks) noexcept;
+
+/// \note: due to need to hide template implementation. Automata with 64-bit states
+one_step one_step_generation(automates::buchi::atm_size repetition,
+                                 const callbacks_handler<automates::basic_frozen_buchi<uint64_t>> &callbacks) noexcept;
+
 } // namespace emptiness_check::statistic
@@ -0,0 +1,58 @@
+#include "automates/acceptance.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace automates
+{
+
+template<typename State>
+basic_acceptance<State>::basic_acceptance(finals_container finals) noexcept
+    : m_final_states(std::move(finals)), m_mask_words(mask::words_num(m_final_states.size()))
+{
+    assert(!m_final_states.empty() && "Empty finals");
+    for (const auto& set : m_final_states)
+    {
+        assert(!set.empty() && "Empty final set");
+        m_mask_states.insert(m_mask_states.end(), set.begin(), set.end());
+    }
+    std::sort(m_mask_states.begin(), m_mask_states.end());
+    m_mask_states.erase(std::unique(m_mask_states.begin(), m_mask_states.end()), m_mask_states.end());
+
+    // rows indexed by the state are kept while they are not bigger than the rows of the final states only
+    const std::size_t row_bytes = m_mask_words * sizeof(mask::word);
+    const std::size_t dense_rows = static_cast<std::size_t>(m_mask_states.back()) + 1;
+    if (dense_rows * row_bytes <= m_mask_states.size() * (row_bytes + sizeof(atm_size)))
+    {
+        m_masks_bound = dense_rows;
+        m_mask_states = {};
+    }
+    else
+    {
+        m_masks_bound = m_mask_states.size();
+        m_mask_states.shrink_to_fit();
+    }
+
+    // one extra (empty) row for all non-final states
+    m_masks.assign((m_masks_bound + 1) * m_mask_words, 0);
+    for (std::size_t i = 0; i < m_final_states.size(); ++i)
+        for (const auto& state : m_final_states[i])
+            m_masks[mask_row(state) * m_mask_words + i / mask::WORD_BITS] |= mask::word{1} << (i % mask::WORD_BITS);
+}
+
+template<typename State>
+memory_report basic_acceptance<State>::memory_usage() const noexcept
+{
+    std::size_t bytes = memory::vector_bytes(m_final_states) + memory::vector_bytes(m_mask_states) +
+                        memory::vector_bytes(m_masks);
+    for (const auto& set : m_final_states)
+        bytes += memory::hashed_bytes(set);
+
+    return { .finals = bytes };
+}
+
+template class basic_acceptance<uint16_t>;
+template class basic_acceptance<uint32_t>;
+template class basic_acceptance<uint64_t>;
+
+} // namespace automates
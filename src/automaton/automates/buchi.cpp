@@ -5,46 +5,43 @@
 namespace automates
 {
 
-buchi::buchi(finals_container finals, table_container trans_table) noexcept
-    : m_final_states(std::move(finals)), m_trans_table(std::move(trans_table))
+template<typename State>
+basic_buchi<State>::basic_buchi(finals_container finals, table_container trans_table, arena_ptr arena) noexcept
+    : basic_acceptance<State>(std::move(finals)), m_arena(std::move(arena)), m_trans_table(std::move(trans_table))
 {
-    assert(!m_final_states.empty() && "Empty finals");
-    for (const auto& set : m_final_states)
-        assert(!set.empty() && "Empty final set");
-
     assert(!m_trans_table.empty() && "Empty transition table");
     for (const auto& [curr_st, set] : m_trans_table)
         assert(!set.empty() && "Empty transition map");
 }
 
-bool buchi::is_final(const atm_size state, const std::optional<atm_size> set_num) const noexcept
+template<typename State>
+basic_buchi<State>::basic_buchi(const basic_buchi& other) noexcept
+    : basic_acceptance<State>(other), m_arena(make_arena(other.get_construction())),
+      m_trans_table(other.m_trans_table, resource_of(m_arena))
+{}
+
+template<typename State>
+typename basic_buchi<State>::successors_range basic_buchi<State>::successors(const atm_size state) const noexcept
 {
-    if (set_num)
-    {
-        // return false on too big final set index
-        return *set_num < m_final_states.size() ?
-            m_final_states[*set_num].find(state) != m_final_states[*set_num].end() :
-            false;
-    }
-
-    for (const auto& set : m_final_states)
-        if (set.find(state) != set.end())
-            return true;
-
-    return false;
+    static const std::pmr::unordered_set<atm_size> no_successors = {};
+
+    if (auto iter = m_trans_table.find(state); iter != m_trans_table.end())
+        return iter->second;
+
+    return no_successors;
 }
 
-buchi::indexes_set buchi::indexes_final_sets(const atm_size state) const noexcept
+template<typename State>
+memory_report basic_buchi<State>::memory_usage() const noexcept
 {
-    indexes_set res;
-    res.reserve(m_final_states.size());
-
-    for (atm_size i = 0; i < m_final_states.size(); ++i)
-        if (m_final_states[i].find(state) != m_final_states[i].end())
-            res.push_back(i);
+    auto report = basic_acceptance<State>::memory_usage();
+    report.transitions = memory::nested_hashed_bytes(m_trans_table);
 
-    res.shrink_to_fit();
-    return std::move(res);
+    return report;
 }
 
+template class basic_buchi<uint16_t>;
+template class basic_buchi<uint32_t>;
+template class basic_buchi<uint64_t>;
+
 } // namespace automates
@@ -0,0 +1,93 @@
+#include "automates/frozen_buchi.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace automates
+{
+
+template<typename State>
+basic_frozen_buchi<State>::basic_frozen_buchi(finals_container finals, const table_container &trans_table) noexcept
+    : basic_acceptance<State>(std::move(finals))
+{
+    assert(!trans_table.empty() && "Empty transition table");
+
+    atm_size bound = 0;
+    std::size_t edges_num = 0;
+    for (const auto& [from, set] : trans_table)
+    {
+        assert(!set.empty() && "Empty transition map");
+        bound = std::max(bound, from);
+        for (const auto& to : set)
+            bound = std::max(bound, to);
+        edges_num += set.size();
+    }
+
+    // count successors per row and then shift them into the offsets
+    m_offsets.assign(static_cast<std::size_t>(bound) + 2, 0);
+    for (const auto& [from, set] : trans_table)
+        m_offsets[static_cast<std::size_t>(from) + 1] = set.size();
+    for (std::size_t i = 1; i < m_offsets.size(); ++i)
+        m_offsets[i] += m_offsets[i - 1];
+
+    m_successors.resize(edges_num);
+    for (const auto& [from, set] : trans_table)
+    {
+        auto row = m_successors.begin() + m_offsets[from];
+        std::copy(set.begin(), set.end(), row);
+        std::sort(row, row + set.size());
+    }
+}
+
+template<typename State>
+basic_frozen_buchi<State>::basic_frozen_buchi(finals_container finals, edges_container edges) noexcept
+    : basic_acceptance<State>(std::move(finals))
+{
+    assert(!edges.empty() && "Empty transition table");
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    atm_size bound = edges.back().first;
+    for (const auto& [_, to] : edges)
+        bound = std::max(bound, to);
+
+    m_offsets.assign(static_cast<std::size_t>(bound) + 2, 0);
+    m_successors.reserve(edges.size());
+    // edges are sorted: rows come one after another
+    for (const auto& [from, to] : edges)
+    {
+        ++m_offsets[static_cast<std::size_t>(from) + 1];
+        m_successors.push_back(to);
+    }
+    for (std::size_t i = 1; i < m_offsets.size(); ++i)
+        m_offsets[i] += m_offsets[i - 1];
+}
+
+template<typename State>
+basic_frozen_buchi<State>::basic_frozen_buchi(finals_container finals, offsets_container offsets,
+                                              csr_container successors) noexcept
+    : basic_acceptance<State>(std::move(finals)), m_offsets(std::move(offsets)), m_successors(std::move(successors))
+{
+    assert(m_offsets.size() > 1 && !m_successors.empty() && "Empty transition table");
+    assert(m_offsets.front() == 0 && m_offsets.back() == m_successors.size() && "Broken offsets");
+
+    for (std::size_t i = 0; i + 1 < m_offsets.size(); ++i)
+    {
+        assert(m_offsets[i] <= m_offsets[i + 1] && "Offsets must not decrease");
+        std::sort(m_successors.begin() + m_offsets[i], m_successors.begin() + m_offsets[i + 1]);
+        assert(std::adjacent_find(m_successors.begin() + m_offsets[i], m_successors.begin() + m_offsets[i + 1]) ==
+               m_successors.begin() + m_offsets[i + 1] && "Duplicated transition");
+    }
+}
+
+template<typename State>
+basic_frozen_buchi<State>::basic_frozen_buchi(const basic_buchi<State> &automat) noexcept
+    : basic_frozen_buchi(automat.get_final_states(), automat.m_trans_table)
+{}
+
+template class basic_frozen_buchi<uint16_t>;
+template class basic_frozen_buchi<uint32_t>;
+template class basic_frozen_buchi<uint64_t>;
+
+} // namespace automates
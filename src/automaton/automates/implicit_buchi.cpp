@@ -0,0 +1,42 @@
+#include "automates/implicit_buchi.hpp"
+
+#include <cassert>
+
+namespace automates
+{
+
+template<typename State>
+basic_implicit_buchi<State>::basic_implicit_buchi(const std::size_t sets_num) noexcept
+    : m_sets_num(sets_num), m_mask_words(mask::words_num(sets_num))
+{
+    assert(sets_num && "Empty finals");
+}
+
+template<typename State>
+basic_callback_buchi<State>::basic_callback_buchi(const std::size_t sets_num, successors_fn succ,
+                                                  acceptance_fn acc) noexcept
+    : basic_implicit_buchi<State>(sets_num), m_successors(std::move(succ)), m_acceptance(std::move(acc)),
+      m_marks(this->get_mask_words_num(), 0)
+{
+    assert(m_successors && m_acceptance && "Empty callbacks");
+}
+
+template<typename State>
+typename basic_implicit_buchi<State>::indexes_set basic_callback_buchi<State>::acceptance(const State state)
+        const noexcept
+{
+    std::fill(m_marks.begin(), m_marks.end(), 0);
+    m_acceptance(state, m_marks);
+
+    return m_marks;
+}
+
+template class basic_implicit_buchi<uint16_t>;
+template class basic_implicit_buchi<uint32_t>;
+template class basic_implicit_buchi<uint64_t>;
+
+template class basic_callback_buchi<uint16_t>;
+template class basic_callback_buchi<uint32_t>;
+template class basic_callback_buchi<uint64_t>;
+
+} // namespace automates
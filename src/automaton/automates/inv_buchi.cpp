@@ -1,20 +1,18 @@
 #include "automates/inv_buchi.hpp"
 
-#include <cassert>
-
 namespace automates
 {
 
-inv_buchi::inv_buchi(buchi&& automat) noexcept
-    : m_trans_table_inv(std::move(inv_buchi::inverse_trans_table(m_trans_table))),
-      m_set_of_states(collect_states(m_trans_table)),
-      buchi(automat)
-{
-    assert(!is_generalized() && "Need to provide NBA");
-}
+template<typename State>
+basic_inv_buchi<State>::basic_inv_buchi(basic_buchi<State>&& automat) noexcept
+    : m_trans_table_inv(std::move(basic_inv_buchi::inverse_trans_table(this->m_trans_table))),
+      m_set_of_states(collect_states(this->m_trans_table)),
+      basic_buchi<State>(std::move(automat))
+{}
 
-std::optional<buchi::table_container::const_iterator> inv_buchi::acceptable_inv_transitions(
-        const atm_size state) const noexcept
+template<typename State>
+std::optional<typename basic_inv_buchi<State>::table_container::const_iterator>
+basic_inv_buchi<State>::acceptable_inv_transitions(const atm_size state) const noexcept
 {
     if (auto iter = m_trans_table_inv.find(state); iter != m_trans_table_inv.end())
         return iter;
@@ -22,9 +20,12 @@ std::optional<buchi::table_container::const_iterator> inv_buchi::acceptable_inv_
     return std::nullopt;
 }
 
-std::unordered_set<automates::buchi::atm_size> inv_buchi::collect_states(const buchi::table_container &trans_table) noexcept
+template<typename State>
+std::pmr::unordered_set<typename basic_inv_buchi<State>::atm_size> basic_inv_buchi<State>::collect_states(
+        const table_container &trans_table) noexcept
 {
-    std::unordered_set<automates::buchi::atm_size> container;
+    // the same memory source (heap or arena) as the direct table
+    std::pmr::unordered_set<atm_size> container(trans_table.get_allocator().resource());
     for (const auto& [from, set] : trans_table)
         for (const auto& to : set)
             container.insert({ from, to });
@@ -32,9 +33,12 @@ std::unordered_set<automates::buchi::atm_size> inv_buchi::collect_states(const b
     return std::move(container);
 }
 
-buchi::table_container inv_buchi::inverse_trans_table(const buchi::table_container &trans_table) noexcept
+template<typename State>
+typename basic_inv_buchi<State>::table_container basic_inv_buchi<State>::inverse_trans_table(
+        const table_container &trans_table) noexcept
 {
-    table_container container;
+    // the same memory source (heap or arena) as the direct table
+    table_container container(trans_table.get_allocator().resource());
     for (const auto&[q, set] : trans_table)
         for (const auto& qt : set)
             container[qt].insert(q);
@@ -42,4 +46,17 @@ buchi::table_container inv_buchi::inverse_trans_table(const buchi::table_contain
     return std::move(container);
 }
 
+template<typename State>
+memory_report basic_inv_buchi<State>::memory_usage() const noexcept
+{
+    auto report = basic_buchi<State>::memory_usage();
+    report.inverse = memory::nested_hashed_bytes(m_trans_table_inv) + memory::hashed_bytes(m_set_of_states);
+
+    return report;
+}
+
+template class basic_inv_buchi<uint16_t>;
+template class basic_inv_buchi<uint32_t>;
+template class basic_inv_buchi<uint64_t>;
+
 } // namespace automates
@@ -1,6 +1,9 @@
 #include "utils/converters.hpp"
 
-#include <queue>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory_resource>
 
 /// \brief hash_combine you could hash an entire (ordered) container, for example, as long as each member
 /// is individually hashable
@@ -36,87 +39,162 @@ namespace
 
 /// \typedef helper for conversion
 /// \note need to be the same with std::hash
-using pr = std::pair<buchi::atm_size, buchi::atm_size>;
-
-/// \brief Translate unique paired states into the numbered and constructs new NBA
-/// \param Q: all paired states
-/// \param Q0: initial paired state
-/// \param F: final states (one set) in paired states
-/// \param delta: transition table in paired states
-/// \return new NBA automaton (not generalized)
-buchi decode_paired_states(const std::unordered_set<pr> &Q, const pr &Q0,
-                           const std::unordered_set<pr> &F,
-                           const std::unordered_map<pr, std::unordered_set<pr>> &delta)
+template<typename State>
+using pr = std::pair<State, State>;
+
+/// \brief Stop the conversion when the new paired state can not be numbered by the state type
+/// \note Wrapped numbers would merge different paired states and silently change the language.
+///     The maximal value stays free: it marks the unvisited states
+/// \param State: state type of the automaton
+/// \param number: number of the new paired state
+template<typename State>
+void check_numbering(const std::size_t number) noexcept
 {
-    std::unordered_map<pr, buchi::atm_size> dict;
-    dict.reserve(Q.size());
-
-    buchi::atm_size state_num = 0;
-    for (const auto& it : Q)
-        // reserve default initial state value correctly for the new automaton
-        if (it == Q0)
-            dict[it] = automates::buchi::INITIAL_STATE;
-        else
-            dict[it] = state_num == automates::buchi::INITIAL_STATE ? ++state_num : state_num++;
-
-    std::unordered_set<buchi::atm_size> new_F;
-    new_F.reserve(F.size());
-    for (const auto& itF : F)
-        new_F.insert(dict[itF]);
-
-    buchi::table_container new_delta;
-    new_delta.reserve(delta.size());
-    for (const auto& [old_st, set] : delta)
-        for (const auto& new_st : set)
-            new_delta[dict[old_st]].insert(dict[new_st]);
-
-    return buchi({std::move(new_F) }, std::move(new_delta));
+    if (number < std::numeric_limits<State>::max())
+        return;
+
+    std::cerr << "NGA-to-NBA conversion: paired states do not fit the " << 8 * sizeof(State) << "-bit state type\n";
+    std::abort();
 }
 
 } // namespace anonymous
 
-std::optional<buchi> nga2nba(const buchi& automat) noexcept
+template<typename State>
+std::optional<basic_buchi<State>> nga2nba(const basic_buchi<State>& automat) noexcept
 {
     if (!automat.is_generalized())
         return std::nullopt;
 
-    // state and final state new containers
-    std::unordered_set<pr> Q, F;
+    /// \note all temporary containers are bump-allocated and released at once on exit
+    std::pmr::monotonic_buffer_resource scratch;
+
+    // new state number for each paired state
+    std::pmr::unordered_map<pr<State>, State> dict(&scratch);
+    // paired states in order of their numbering. Index is a new state number
+    std::pmr::vector<pr<State>> Q(&scratch);
+
+    // result is constructed in the same way as the source automaton
+    auto arena = make_arena(automat.get_construction());
+    // new final states container
+    std::unordered_set<State> F;
     // container for the new transition table
-    std::unordered_map<pr, std::unordered_set<pr>> delta;
+    typename basic_buchi<State>::table_container delta(resource_of(arena));
+
     // new initial point
-    pr Q0 {automates::buchi::INITIAL_STATE, 0};
+    Q.emplace_back(basic_buchi<State>::INITIAL_STATE, 0);
+    dict.emplace(Q.front(), basic_buchi<State>::INITIAL_STATE);
 
-    // queue tracker for new generated state
-    std::queue<pr> W;
-    W.push(Q0);
-    while (!W.empty())
+    /// \note BFS queue is the tail of Q: paired states are numbered (and enqueued only once) on discovery
+    for (std::size_t head = 0; head < Q.size(); ++head)
     {
         // current tracked new state
-        auto pair = W.front();
-        auto& [q, i] = pair;
-        W.pop();
+        const auto [q, i] = Q[head];
 
-        Q.insert(pair);
         if (automat.is_final(q, 0) && i == 0)
-            F.insert(pair);
+            F.insert(head);
 
-        if (auto iter = automat.m_trans_table.find(q); iter != automat.m_trans_table.end())
+        // generate either new or current states copy
+        const State next_i = automat.is_final(q, i) ? (i + 1) % automat.get_final_num_sets() : i;
+        for (const auto& qt : automat.successors(q))
         {
-            for (const auto& qt : iter->second)
+            auto [iter, inserted] = dict.try_emplace({ qt, next_i }, Q.size());
+            if (inserted)
             {
-                // generate either new or current states copy
-                pr new_pair {qt, automat.is_final(q, i) ? (i + 1) % automat.get_final_num_sets() : i};
-                if (Q.find(new_pair) == Q.end())
-                    W.push(new_pair);
+                check_numbering<State>(Q.size());
+                Q.push_back(iter->first);
+            }
+
+            // accepted state for current tracked state
+            delta[head].insert(iter->second);
+        }
+    }
+
+    /// \note no accepting pair or no transition is reachable: the language is empty. The unreachable accepting sink
+    ///     (the next free number) keeps the final set and the table not empty
+    if (F.empty() || delta.empty())
+    {
+        check_numbering<State>(Q.size());
+        const auto sink = static_cast<State>(Q.size());
+        F.insert(sink);
+        delta[sink].insert(sink);
+    }
+
+    return basic_buchi<State>({ std::move(F) }, std::move(delta), std::move(arena));
+}
+
+template<typename State>
+std::optional<basic_frozen_buchi<State>> nga2nba(const basic_frozen_buchi<State>& automat) noexcept
+{
+    if (!automat.is_generalized())
+        return std::nullopt;
 
-                // accepted state for current tracked state
-                delta[pair].insert(new_pair);
+    const std::size_t sets_num = automat.get_final_num_sets();
+    /// \note paired state <q, i> has the dense index q * sets_num + i
+    auto encode = [sets_num](const std::size_t q, const std::size_t i) { return q * sets_num + i; };
+
+    // new state number for each paired state. Unvisited are marked by the maximal value
+    constexpr State UNVISITED = std::numeric_limits<State>::max();
+    std::vector<State> dict(automat.get_states_bound() * sets_num, UNVISITED);
+    // paired states in order of their numbering. Index is a new state number
+    std::vector<pr<State>> Q;
+
+    // new final states container
+    std::unordered_set<State> F;
+    // CSR arrays for the new transition table
+    typename basic_frozen_buchi<State>::offsets_container offsets{ 0 };
+    typename basic_frozen_buchi<State>::csr_container successors;
+
+    // new initial point
+    Q.emplace_back(basic_frozen_buchi<State>::INITIAL_STATE, 0);
+    dict[encode(basic_frozen_buchi<State>::INITIAL_STATE, 0)] = basic_frozen_buchi<State>::INITIAL_STATE;
+
+    /// \note BFS queue is the tail of Q: states are numbered in the order of their discovery,
+    /// so rows are generated one after another
+    for (std::size_t head = 0; head < Q.size(); ++head)
+    {
+        // current tracked new state
+        const auto [q, i] = Q[head];
+
+        if (automat.is_final(q, 0) && i == 0)
+            F.insert(head);
+
+        // generate either new or current states copy
+        const State next_i = automat.is_final(q, i) ? (i + 1) % sets_num : i;
+        for (const auto& qt : automat.successors(q))
+        {
+            auto& num = dict[encode(qt, next_i)];
+            if (num == UNVISITED)
+            {
+                check_numbering<State>(Q.size());
+                num = Q.size();
+                Q.emplace_back(qt, next_i);
             }
+            // accepted state for current tracked state
+            successors.push_back(num);
         }
+        offsets.push_back(successors.size());
+    }
+
+    /// \note no accepting pair or no transition is reachable: the language is empty. The unreachable accepting sink
+    ///     (the next free number) keeps the final set and the table not empty
+    if (F.empty() || successors.empty())
+    {
+        check_numbering<State>(Q.size());
+        const auto sink = static_cast<State>(Q.size());
+        F.insert(sink);
+        successors.push_back(sink);
+        offsets.push_back(successors.size());
     }
 
-    return decode_paired_states(Q, Q0, F, delta);
+    return basic_frozen_buchi<State>({ std::move(F) }, std::move(offsets), std::move(successors));
 }
 
+template std::optional<basic_buchi<uint16_t>> nga2nba(const basic_buchi<uint16_t>&) noexcept;
+template std::optional<basic_buchi<uint32_t>> nga2nba(const basic_buchi<uint32_t>&) noexcept;
+template std::optional<basic_buchi<uint64_t>> nga2nba(const basic_buchi<uint64_t>&) noexcept;
+
+template std::optional<basic_frozen_buchi<uint16_t>> nga2nba(const basic_frozen_buchi<uint16_t>&) noexcept;
+template std::optional<basic_frozen_buchi<uint32_t>> nga2nba(const basic_frozen_buchi<uint32_t>&) noexcept;
+template std::optional<basic_frozen_buchi<uint64_t>> nga2nba(const basic_frozen_buchi<uint64_t>&) noexcept;
+
 } // namespace utils::converters
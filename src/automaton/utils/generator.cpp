@@ -8,15 +8,20 @@
 namespace
 {
 
+/// \typedef Number of the generated items (states, edges, sets)
+using gen_size = utils::generator::generator_opts::gen_size;
+
 /// \brief Generate oriented one-connected tree
+/// \param State: state type of the generated automaton
 /// \param states_num: number of vertex in tree
 /// \param alphabet: number of different edges
 /// \param edges: number of edges for each_vertex
 /// \param is_initial: should we left root equal to 0 (initial automaton state) and connect it with all states
-/// \return randomized transition table, but consisting of the one tree
-automates::buchi::table_container generate_tree(const automates::buchi::atm_size states_num,
-                                                const automates::buchi::atm_size edges,
-                                                const bool is_initial = false) noexcept
+/// \return randomized transitions list, but consisting of the one tree
+template<typename State>
+typename automates::basic_frozen_buchi<State>::edges_container generate_tree(const gen_size states_num,
+                                                                            const gen_size edges,
+                                                                            const bool is_initial = false) noexcept
 {
     // check on emptiness
     if (!states_num || !edges)
@@ -26,24 +31,24 @@ automates::buchi::table_container generate_tree(const automates::buchi::atm_size
     std::mt19937 rng(dev());
 
     // store states for visit. Where index - is a number of the turn and value is a state
-    std::vector<automates::buchi::atm_size> stotage(states_num);
+    std::vector<State> stotage(states_num);
     // increasing fill elements from 0 to size()
     std::iota(stotage.begin(), stotage.end(), 0);
     // randomize state selection. Left 0 without changes (correct start point)
-    std::shuffle(stotage.begin() + static_cast<automates::buchi::atm_size>(is_initial), stotage.end(), rng);
+    std::shuffle(stotage.begin() + static_cast<gen_size>(is_initial), stotage.end(), rng);
 
-    automates::buchi::table_container tree;
+    typename automates::basic_frozen_buchi<State>::edges_container tree;
     // fully connected for initial state. Otherwise, tree could be smaller then max
-    const automates::buchi::atm_size max_turns = is_initial ? stotage.size() :
-                               std::uniform_int_distribution<automates::buchi::atm_size>(1, stotage.size())(rng);
+    const gen_size max_turns = is_initial ? stotage.size() :
+                               std::uniform_int_distribution<gen_size>(1, stotage.size())(rng);
     // usage of a state: visited or not. Index of a @storage
-    for (automates::buchi::atm_size turn = 0; turn < max_turns; ++turn)
+    for (gen_size turn = 0; turn < max_turns; ++turn)
     {
         // generate edges for current state
-        for (automates::buchi::atm_size i = 0; i <= edges && turn < stotage.size() - i; ++i)
+        for (gen_size i = 0; i <= edges && turn < stotage.size() - i; ++i)
         {
             /// \note: symbol may be overwritten during further tree merge
-            tree[stotage[turn]].insert(stotage[turn + i]);
+            tree.emplace_back(stotage[turn], stotage[turn + i]);
         }
     }
 
@@ -51,13 +56,15 @@ automates::buchi::table_container generate_tree(const automates::buchi::atm_size
 }
 
 /// \brief Generate final state sets
+/// \param State: state type of the generated automaton
 /// \param states_num: number of states in automaton
 /// \param set_num: number of sets in the final container
 /// \param ratio: special experimental value to control maximum elements in one set. Use number of edges for each vertex
 /// \return randomized final states container
-automates::buchi::finals_container generate_finals(const automates::buchi::atm_size states_num,
-                                                   const automates::buchi::atm_size set_num,
-                                                   const automates::buchi::atm_size ratio) noexcept
+template<typename State>
+typename automates::basic_acceptance<State>::finals_container generate_finals(const gen_size states_num,
+                                                                             const gen_size set_num,
+                                                                             const gen_size ratio) noexcept
 {
     // check on emptiness
     if (!states_num || !set_num || !ratio)
@@ -67,37 +74,71 @@ automates::buchi::finals_container generate_finals(const automates::buchi::atm_s
     std::mt19937 rng(dev());
 
     // Some manual decrease for maximum final states number per set
-    std::uniform_int_distribution<automates::buchi::atm_size> dist_set(1,
+    std::uniform_int_distribution<gen_size> dist_set(1,
             std::max(static_cast<double>(states_num) / set_num / ratio, 1.0));
     // Distribution for final states
-    std::uniform_int_distribution<automates::buchi::atm_size> dist(0, states_num - 1);
-    automates::buchi::finals_container finals(set_num);
+    std::uniform_int_distribution<State> dist(0, states_num - 1);
+    typename automates::basic_acceptance<State>::finals_container finals(set_num);
 
     for (auto& set : finals)
     {
         auto max_in_set = dist_set(rng);
         set.reserve(max_in_set);
-        for (automates::buchi::atm_size i = 0; i < max_in_set; ++i)
+        for (gen_size i = 0; i < max_in_set; ++i)
             set.insert(dist(rng));
     }
 
     return std::move(finals);
 }
 
-} // namespace anonymous
-
-automates::buchi utils::generator::generate_automaton(const generator_opts& opts) noexcept
+/// \brief Generate merged trees transitions
+/// \param State: state type of the generated automaton
+/// \param opts: generator options
+/// \return transitions list of all trees. The same transition may occur several times
+template<typename State>
+typename automates::basic_frozen_buchi<State>::edges_container generate_edges(
+        const utils::generator::generator_opts& opts) noexcept
 {
-    automates::buchi::table_container transitions;
+    typename automates::basic_frozen_buchi<State>::edges_container transitions;
     // trees generating and merging
-    for (automates::buchi::atm_size tree = 0; tree < opts.trees; ++tree)
+    for (gen_size tree = 0; tree < opts.trees; ++tree)
     {
-        auto gt = generate_tree(opts.states, opts.edges, tree == 0);
-        // merging trees
-        for (auto& [from, set] : gt)
-            for (auto& to : set)
-                transitions[from].insert(to);
+        auto gt = generate_tree<State>(opts.states, opts.edges, tree == 0);
+        transitions.insert(transitions.end(), gt.begin(), gt.end());
     }
 
-    return automates::buchi(generate_finals(opts.states, opts.sets, opts.edges), std::move(transitions));
+    return std::move(transitions);
+}
+
+} // namespace anonymous
+
+template<typename State>
+automates::basic_buchi<State> utils::generator::generate_automaton(const generator_opts& opts) noexcept
+{
+    auto arena = automates::make_arena(opts.arena ? automates::construction::arena : automates::construction::heap);
+    typename automates::basic_buchi<State>::table_container transitions(automates::resource_of(arena));
+    // merging trees
+    for (const auto& [from, to] : generate_edges<State>(opts))
+        transitions[from].insert(to);
+
+    return automates::basic_buchi<State>(generate_finals<State>(opts.states, opts.sets, opts.edges),
+                                         std::move(transitions), std::move(arena));
 }
+
+template<typename State>
+automates::basic_frozen_buchi<State> utils::generator::generate_frozen_automaton(const generator_opts& opts) noexcept
+{
+    return automates::basic_frozen_buchi<State>(generate_finals<State>(opts.states, opts.sets, opts.edges),
+                                                generate_edges<State>(opts));
+}
+
+template automates::basic_buchi<uint16_t> utils::generator::generate_automaton(const generator_opts&) noexcept;
+template automates::basic_buchi<uint32_t> utils::generator::generate_automaton(const generator_opts&) noexcept;
+template automates::basic_buchi<uint64_t> utils::generator::generate_automaton(const generator_opts&) noexcept;
+
+template automates::basic_frozen_buchi<uint16_t> utils::generator::generate_frozen_automaton(
+        const generator_opts&) noexcept;
+template automates::basic_frozen_buchi<uint32_t> utils::generator::generate_frozen_automaton(
+        const generator_opts&) noexcept;
+template automates::basic_frozen_buchi<uint64_t> utils::generator::generate_frozen_automaton(
+        const generator_opts&) noexcept;
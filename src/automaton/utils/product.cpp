@@ -0,0 +1,66 @@
+#include "utils/product.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <cassert>
+
+namespace utils::product
+{
+
+template<typename State>
+basic_engine<State>::basic_engine(system_fn system, automates::basic_frozen_buchi<State> property,
+                                  guard_fn guard) noexcept
+    : automates::basic_implicit_buchi<State>(property.get_final_num_sets()),
+      m_system(std::move(system)), m_property(std::move(property)), m_guard(std::move(guard)),
+      // the initial property state always has its own place in the encoding
+      m_width(static_cast<atm_size>(std::clamp<std::size_t>(m_property.get_states_bound(), 1,
+                                                            std::numeric_limits<State>::max()))),
+      m_max_system(static_cast<atm_size>((std::numeric_limits<State>::max() - (m_width - 1)) / m_width))
+{
+    assert(m_system && "Empty system");
+    if (m_property.get_states_bound() <= std::numeric_limits<State>::max())
+        return;
+
+    std::cerr << "Product: property states do not fit the " << 8 * sizeof(State) << "-bit product state type\n";
+    std::abort();
+}
+
+template<typename State>
+basic_engine<State>::basic_engine(system_fn system, const automates::basic_buchi<State> &property,
+                                  guard_fn guard) noexcept
+    : basic_engine(std::move(system), automates::basic_frozen_buchi<State>(property), std::move(guard))
+{}
+
+template<typename State>
+void basic_engine<State>::successors(const atm_size state, successors_buffer &out) const noexcept
+{
+    ++m_expanded;
+
+    const auto p = property_state(state);
+    const auto &&targets = m_property.successors(p);
+    if (targets.empty())
+        return;
+
+    m_system_successors.clear();
+    m_system(system_state(state), m_system_successors);
+    for (const auto s : m_system_successors)
+        for (const auto t : targets)
+            if (!m_guard || m_guard(s, t))
+                out.push_back(encode(s, t));
+}
+
+template<typename State>
+void basic_engine<State>::overflow(const atm_size system) noexcept
+{
+    std::cerr << "Product: system state " << system << " does not fit the " << 8 * sizeof(State) <<
+              "-bit product state type\n";
+    std::abort();
+}
+
+template class basic_engine<uint16_t>;
+template class basic_engine<uint32_t>;
+template class basic_engine<uint64_t>;
+
+} // namespace utils::product
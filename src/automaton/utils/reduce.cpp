@@ -0,0 +1,416 @@
+#include "utils/reduce.hpp"
+
+#include <algorithm>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace utils::reduce
+{
+
+using namespace automates;
+
+/// \namespace Anonymous namespace. Helpers with the kept states searches
+namespace
+{
+
+/// \typedef Set of the kept states
+template<typename State>
+using states_set = std::pmr::unordered_set<State>;
+
+/// \brief Predecessors of the state
+/// \param automat: automaton with the inverse transition table
+/// \param state: automaton state
+/// \return pointer to the predecessors set or nullptr if there are no predecessors
+template<typename State>
+const std::pmr::unordered_set<State>* predecessors(const basic_inv_buchi<State> &automat, const State state) noexcept
+{
+    const auto iter = automat.acceptable_inv_transitions(state);
+    return iter ? &(*iter)->second : nullptr;
+}
+
+/// \brief Peel off the kept states without kept successors
+/// \param automat: automaton with the inverse transition table
+/// \param[in, out] alive: kept states
+/// \param scratch: memory of the temporary containers
+template<typename State>
+void remove_dead_ends(const basic_inv_buchi<State> &automat, states_set<State> &alive,
+                      std::pmr::memory_resource *scratch) noexcept
+{
+    std::pmr::unordered_map<State, std::size_t> degree(scratch);
+    std::pmr::vector<State> dead(scratch);
+    for (const auto q : alive)
+    {
+        std::size_t d = 0;
+        for (const auto s : automat.successors(q))
+            d += alive.contains(s);
+        degree.emplace(q, d);
+        if (!d)
+            dead.push_back(q);
+    }
+
+    while (!dead.empty())
+    {
+        const auto q = dead.back();
+        dead.pop_back();
+        alive.erase(q);
+
+        if (const auto* pred = predecessors(automat, q))
+            for (const auto p : *pred)
+                if (alive.contains(p) && !--degree[p])
+                    dead.push_back(p);
+    }
+}
+
+/// \brief Keep only the states that reach the final set (in zero or more steps inside the kept states)
+/// \param automat: automaton with the inverse transition table
+/// \param[in, out] alive: kept states
+/// \param set_num: final set index
+/// \param scratch: memory of the temporary containers
+/// \return true if some states were removed
+template<typename State>
+bool keep_reaching(const basic_inv_buchi<State> &automat, states_set<State> &alive, const std::size_t set_num,
+                   std::pmr::memory_resource *scratch) noexcept
+{
+    states_set<State> reaching(scratch);
+    std::pmr::vector<State> queue(scratch);
+    for (const auto f : automat.get_final_states()[set_num])
+        if (alive.contains(f) && reaching.insert(f).second)
+            queue.push_back(f);
+
+    /// \note BFS queue is the tail of @queue
+    for (std::size_t head = 0; head < queue.size(); ++head)
+        if (const auto* pred = predecessors(automat, queue[head]))
+            for (const auto p : *pred)
+                if (alive.contains(p) && reaching.insert(p).second)
+                    queue.push_back(p);
+
+    if (reaching.size() == alive.size())
+        return false;
+
+    alive = std::move(reaching);
+    return true;
+}
+
+/// \brief Keep only the states reachable from INITIAL_STATE (inside the kept states)
+/// \param automat: automaton with the inverse transition table
+/// \param[in, out] alive: kept states
+/// \param scratch: memory of the temporary containers
+/// \return true if some states were removed
+template<typename State>
+bool keep_reachable(const basic_inv_buchi<State> &automat, states_set<State> &alive,
+                    std::pmr::memory_resource *scratch) noexcept
+{
+    states_set<State> reachable(scratch);
+    std::pmr::vector<State> queue(scratch);
+    if (alive.contains(basic_buchi<State>::INITIAL_STATE))
+    {
+        reachable.insert(basic_buchi<State>::INITIAL_STATE);
+        queue.push_back(basic_buchi<State>::INITIAL_STATE);
+    }
+
+    /// \note BFS queue is the tail of @queue
+    for (std::size_t head = 0; head < queue.size(); ++head)
+        for (const auto s : automat.successors(queue[head]))
+            if (alive.contains(s) && reachable.insert(s).second)
+                queue.push_back(s);
+
+    if (reachable.size() == alive.size())
+        return false;
+
+    alive = std::move(reachable);
+    return true;
+}
+
+/// \struct Dense kept states of the frozen automaton with the inverse CSR table
+/// \param State: state type of the automaton
+template<typename State>
+struct dense_trim
+{
+    /// \brief Build the inverse table
+    /// \param automat: trimmed automaton
+    explicit dense_trim(const basic_frozen_buchi<State> &automat) noexcept
+        : automat(automat), bound(automat.get_states_bound()), alive(bound, 0), offsets(bound + 1, 0)
+    {
+        for (std::size_t q = 0; q < bound; ++q)
+            for (const auto s : automat.successors(static_cast<State>(q)))
+                ++offsets[static_cast<std::size_t>(s) + 1];
+        for (std::size_t i = 1; i < offsets.size(); ++i)
+            offsets[i] += offsets[i - 1];
+
+        auto next = offsets;
+        predecessors.resize(offsets.back());
+        for (std::size_t q = 0; q < bound; ++q)
+            for (const auto s : automat.successors(static_cast<State>(q)))
+                predecessors[next[s]++] = static_cast<State>(q);
+    }
+
+    /// \brief Predecessors of the state
+    /// \param q: state below the bound
+    /// \return contiguous predecessors range
+    [[nodiscard]] std::span<const State> predecessors_of(const std::size_t q) const noexcept
+    {
+        return { predecessors.data() + offsets[q], predecessors.data() + offsets[q + 1] };
+    }
+
+    /// \brief Keep only the states reachable from INITIAL_STATE (inside the kept states)
+    /// \param restricted: search only the kept states. Otherwise the search sets the kept states
+    /// \return true if some states were removed
+    bool keep_reachable(const bool restricted) noexcept
+    {
+        std::vector<char> reached(bound, 0);
+        std::vector<State> queue;
+        constexpr auto initial = basic_frozen_buchi<State>::INITIAL_STATE;
+        if (initial < bound && (!restricted || alive[initial]))
+        {
+            reached[initial] = 1;
+            queue.push_back(initial);
+        }
+
+        /// \note BFS queue is the tail of @queue
+        for (std::size_t head = 0; head < queue.size(); ++head)
+            for (const auto s : automat.successors(queue[head]))
+                if (s < bound && (!restricted || alive[s]) && !reached[s])
+                {
+                    reached[s] = 1;
+                    queue.push_back(s);
+                }
+
+        return replace(std::move(reached), queue.size());
+    }
+
+    /// \brief Peel off the kept states without kept successors
+    void remove_dead_ends() noexcept
+    {
+        std::vector<std::size_t> degree(bound, 0);
+        std::vector<State> dead;
+        for (std::size_t q = 0; q < bound; ++q)
+        {
+            if (!alive[q])
+                continue;
+            for (const auto s : automat.successors(static_cast<State>(q)))
+                degree[q] += s < bound && alive[s];
+            if (!degree[q])
+                dead.push_back(static_cast<State>(q));
+        }
+
+        while (!dead.empty())
+        {
+            const auto q = dead.back();
+            dead.pop_back();
+            alive[q] = 0;
+            --size;
+
+            for (const auto p : predecessors_of(q))
+                if (alive[p] && !--degree[p])
+                    dead.push_back(p);
+        }
+    }
+
+    /// \brief Keep only the states that reach the final set (in zero or more steps inside the kept states)
+    /// \param set_num: final set index
+    /// \return true if some states were removed
+    bool keep_reaching(const std::size_t set_num) noexcept
+    {
+        std::vector<char> reaching(bound, 0);
+        std::vector<State> queue;
+        for (const auto f : automat.get_final_states()[set_num])
+            if (f < bound && alive[f] && !reaching[f])
+            {
+                reaching[f] = 1;
+                queue.push_back(f);
+            }
+
+        /// \note BFS queue is the tail of @queue
+        for (std::size_t head = 0; head < queue.size(); ++head)
+            for (const auto p : predecessors_of(queue[head]))
+                if (alive[p] && !reaching[p])
+                {
+                    reaching[p] = 1;
+                    queue.push_back(p);
+                }
+
+        return replace(std::move(reaching), queue.size());
+    }
+
+    /// \brief Replace the kept states
+    /// \param kept: new kept states flags
+    /// \param kept_size: number of the new kept states
+    /// \return true if the number of the kept states changed
+    bool replace(std::vector<char> &&kept, const std::size_t kept_size) noexcept
+    {
+        const bool changed = kept_size != size;
+        alive = std::move(kept);
+        size = kept_size;
+
+        return changed;
+    }
+
+    /// \brief trimmed automaton
+    const basic_frozen_buchi<State> &automat;
+    /// \brief states bound of the automaton
+    std::size_t bound;
+    /// \brief kept states flags
+    std::vector<char> alive;
+    /// \brief number of the kept states
+    std::size_t size = 0;
+    /// \brief inverse CSR table: row offsets
+    std::vector<std::size_t> offsets;
+    /// \brief inverse CSR table: predecessors of all states row by row
+    std::vector<State> predecessors = {};
+};
+
+} // namespace anonymous
+
+template<typename State>
+trimmed<basic_buchi<State>> trim(const basic_inv_buchi<State> &automat) noexcept
+{
+    /// \note all temporary containers are bump-allocated and released at once on exit
+    std::pmr::monotonic_buffer_resource scratch;
+
+    // reachable states: forward search over the direct table
+    states_set<State> alive(&scratch);
+    std::pmr::vector<State> queue(&scratch);
+    alive.insert(basic_buchi<State>::INITIAL_STATE);
+    queue.push_back(basic_buchi<State>::INITIAL_STATE);
+    for (std::size_t head = 0; head < queue.size(); ++head)
+        for (const auto s : automat.successors(queue[head]))
+            if (alive.insert(s).second)
+                queue.push_back(s);
+
+    // the cut of the states that can't reach some final set may create new dead ends and cut the states off
+    // from the initial one
+    bool changed = true;
+    while (changed && !alive.empty())
+    {
+        remove_dead_ends(automat, alive, &scratch);
+
+        changed = false;
+        for (std::size_t i = 0; i < automat.get_final_num_sets() && !alive.empty(); ++i)
+            changed |= keep_reaching(automat, alive, i, &scratch);
+        if (changed)
+            keep_reachable(automat, alive, &scratch);
+    }
+
+    trimmed<basic_buchi<State>> result;
+    std::size_t states = automat.m_set_of_states.size() +
+                         !automat.m_set_of_states.contains(basic_buchi<State>::INITIAL_STATE);
+    std::size_t edges = 0;
+    for (const auto& [q, set] : automat.m_trans_table)
+        edges += set.size();
+
+    // every accepting run starts from the initial state
+    if (!alive.contains(basic_buchi<State>::INITIAL_STATE))
+    {
+        result.removed_states = states;
+        result.removed_edges = edges;
+        return result;
+    }
+
+    // result is constructed in the same way as the source automaton
+    auto arena = make_arena(automat.get_construction());
+    typename basic_buchi<State>::table_container delta(resource_of(arena));
+    for (const auto q : alive)
+    {
+        auto& row = delta[q];
+        for (const auto s : automat.successors(q))
+            if (alive.contains(s))
+                row.insert(s);
+        edges -= row.size();
+    }
+
+    /// \note every kept state reaches every final set inside the kept states: no final set becomes empty
+    typename basic_buchi<State>::finals_container finals(automat.get_final_num_sets());
+    for (std::size_t i = 0; i < finals.size(); ++i)
+        for (const auto f : automat.get_final_states()[i])
+            if (alive.contains(f))
+                finals[i].insert(f);
+
+    result.removed_states = states - alive.size();
+    result.removed_edges = edges;
+    result.automaton.emplace(std::move(finals), std::move(delta), std::move(arena));
+
+    return result;
+}
+
+template<typename State>
+trimmed<basic_buchi<State>> trim(const basic_buchi<State> &automat) noexcept
+{
+    return trim(basic_inv_buchi<State>(basic_buchi<State>(automat)));
+}
+
+template<typename State>
+trimmed<basic_frozen_buchi<State>> trim(const basic_frozen_buchi<State> &automat) noexcept
+{
+    dense_trim<State> kept(automat);
+
+    // reachable states: forward search over the direct table
+    kept.keep_reachable(false);
+
+    // same fixpoint as for the hashed automaton
+    bool changed = true;
+    while (changed && kept.size)
+    {
+        kept.remove_dead_ends();
+
+        changed = false;
+        for (std::size_t i = 0; i < automat.get_final_num_sets() && kept.size; ++i)
+            changed |= kept.keep_reaching(i);
+        if (changed)
+            kept.keep_reachable(true);
+    }
+
+    // states are the transitions ends and the initial state
+    std::vector<char> present(kept.bound, 0);
+    present[basic_frozen_buchi<State>::INITIAL_STATE] = 1;
+    for (std::size_t q = 0; q < kept.bound; ++q)
+        for (const auto s : automat.successors(static_cast<State>(q)))
+            present[q] = present[s] = 1;
+
+    trimmed<basic_frozen_buchi<State>> result;
+    result.removed_states = static_cast<std::size_t>(std::count(present.begin(), present.end(), 1)) - kept.size;
+    result.removed_edges = automat.get_edges_num();
+
+    // every accepting run starts from the initial state
+    if (!kept.size)
+        return result;
+
+    // kept states keep their numbers: the rows of the removed ones are empty
+    typename basic_frozen_buchi<State>::offsets_container offsets{ 0 };
+    typename basic_frozen_buchi<State>::csr_container successors;
+    offsets.reserve(kept.bound + 1);
+    for (std::size_t q = 0; q < kept.bound; ++q)
+    {
+        if (kept.alive[q])
+            for (const auto s : automat.successors(static_cast<State>(q)))
+                if (s < kept.bound && kept.alive[s])
+                    successors.push_back(s);
+        offsets.push_back(successors.size());
+    }
+    result.removed_edges -= successors.size();
+
+    /// \note every kept state reaches every final set inside the kept states: no final set becomes empty
+    typename basic_frozen_buchi<State>::finals_container finals(automat.get_final_num_sets());
+    for (std::size_t i = 0; i < finals.size(); ++i)
+        for (const auto f : automat.get_final_states()[i])
+            if (f < kept.bound && kept.alive[f])
+                finals[i].insert(f);
+
+    result.automaton.emplace(std::move(finals), std::move(offsets), std::move(successors));
+
+    return result;
+}
+
+template trimmed<basic_buchi<uint16_t>> trim(const basic_inv_buchi<uint16_t>&) noexcept;
+template trimmed<basic_buchi<uint32_t>> trim(const basic_inv_buchi<uint32_t>&) noexcept;
+template trimmed<basic_buchi<uint64_t>> trim(const basic_inv_buchi<uint64_t>&) noexcept;
+
+template trimmed<basic_buchi<uint16_t>> trim(const basic_buchi<uint16_t>&) noexcept;
+template trimmed<basic_buchi<uint32_t>> trim(const basic_buchi<uint32_t>&) noexcept;
+template trimmed<basic_buchi<uint64_t>> trim(const basic_buchi<uint64_t>&) noexcept;
+
+template trimmed<basic_frozen_buchi<uint16_t>> trim(const basic_frozen_buchi<uint16_t>&) noexcept;
+template trimmed<basic_frozen_buchi<uint32_t>> trim(const basic_frozen_buchi<uint32_t>&) noexcept;
+template trimmed<basic_frozen_buchi<uint64_t>> trim(const basic_frozen_buchi<uint64_t>&) noexcept;
+
+} // namespace utils::reduce
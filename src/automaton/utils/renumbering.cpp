@@ -0,0 +1,335 @@
+#include "utils/renumbering.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+namespace utils::renumbering
+{
+
+using namespace automates;
+
+/// \namespace Anonymous namespace. Helpers with compact graph and orderings
+namespace
+{
+
+/// \typedef compact state number (index in the sorted states list) and new state number
+using atm_size = std::size_t;
+
+/// \brief Marker of the not yet numbered state
+constexpr atm_size UNNUMBERED = std::numeric_limits<atm_size>::max();
+
+/// \brief Visit all transitions of the hashed automaton
+/// \param automat: investigated automaton
+/// \param fn: consumer of the transition (from, to)
+template<typename State, typename F>
+void for_each_transition(const basic_buchi<State> &automat, F&& fn) noexcept
+{
+    for (const auto& [from, set] : automat.m_trans_table)
+        for (const auto& to : set)
+            fn(from, to);
+}
+
+/// \brief Visit all transitions of the frozen automaton
+/// \param automat: investigated automaton
+/// \param fn: consumer of the transition (from, to)
+template<typename State, typename F>
+void for_each_transition(const basic_frozen_buchi<State> &automat, F&& fn) noexcept
+{
+    for (std::size_t from = 0; from < automat.get_states_bound(); ++from)
+        for (const auto& to : automat.successors(from))
+            fn(from, to);
+}
+
+/// \struct Automaton graph over the compact states in CSR form
+/// \param State: original state type
+template<typename State>
+struct compact_graph
+{
+    /// \brief sorted unique original states. Index is a compact state
+    std::vector<State> states;
+    /// \brief rows offsets
+    std::vector<std::size_t> offsets;
+    /// \brief concatenated successors rows
+    std::vector<atm_size> successors;
+
+    /// \brief Compact state of the original one
+    /// \param state: original state (must exist)
+    /// \return index in @states
+    [[nodiscard]] atm_size compact(const State state) const noexcept
+    {
+        return std::lower_bound(states.begin(), states.end(), state) - states.begin();
+    }
+
+    /// \brief Number of states
+    [[nodiscard]] atm_size size() const noexcept { return states.size(); }
+};
+
+/// \brief Collect all states (initial, finals and transitions ends) and build compact CSR graph
+/// \param automat: investigated automaton
+/// \return compact graph
+template<typename Automaton>
+auto build_compact(const Automaton &automat) noexcept
+{
+    using State = typename Automaton::atm_size;
+    compact_graph<State> g;
+
+    g.states.push_back(Automaton::INITIAL_STATE);
+    for (const auto& set : automat.get_final_states())
+        g.states.insert(g.states.end(), set.begin(), set.end());
+    for_each_transition(automat, [&states = g.states](const State from, const State to)
+    {
+        states.push_back(from);
+        states.push_back(to);
+    });
+    std::sort(g.states.begin(), g.states.end());
+    g.states.erase(std::unique(g.states.begin(), g.states.end()), g.states.end());
+
+    // count successors per row and then shift them into the offsets
+    g.offsets.assign(g.states.size() + 1, 0);
+    for_each_transition(automat, [&g](const State from, const State) { ++g.offsets[g.compact(from) + 1]; });
+    std::partial_sum(g.offsets.begin(), g.offsets.end(), g.offsets.begin());
+
+    std::vector<std::size_t> fill(g.offsets.begin(), g.offsets.end() - 1);
+    g.successors.resize(g.offsets.back());
+    for_each_transition(automat, [&g, &fill](const State from, const State to)
+    {
+        g.successors[fill[g.compact(from)]++] = g.compact(to);
+    });
+
+    return g;
+}
+
+/// \brief Numbering roots: initial state first, then the rest in ascending order
+/// \param g: compact graph
+/// \param numbers: new numbers of the compact states (UNNUMBERED if not yet)
+/// \param fn: traversal started from the not yet numbered root
+template<typename State, typename F>
+void for_each_root(const compact_graph<State> &g, const std::vector<atm_size> &numbers, F&& fn) noexcept
+{
+    fn(g.compact(basic_acceptance<State>::INITIAL_STATE));
+    for (atm_size root = 0; root < g.size(); ++root)
+        if (numbers[root] == UNNUMBERED)
+            fn(root);
+}
+
+/// \brief Breadth-first discovery order
+/// \param g: compact graph
+/// \return compact states in the order of new numbers
+template<typename State>
+std::vector<atm_size> bfs_order(const compact_graph<State> &g) noexcept
+{
+    std::vector<atm_size> numbers(g.size(), UNNUMBERED), ord;
+    ord.reserve(g.size());
+
+    for_each_root(g, numbers, [&](const atm_size root)
+    {
+        numbers[root] = ord.size();
+        ord.push_back(root);
+        // queue is the tail of @ord
+        for (std::size_t head = ord.size() - 1; head < ord.size(); ++head)
+            for (auto i = g.offsets[ord[head]]; i < g.offsets[ord[head] + 1]; ++i)
+                if (const auto r = g.successors[i]; numbers[r] == UNNUMBERED)
+                {
+                    numbers[r] = ord.size();
+                    ord.push_back(r);
+                }
+    });
+
+    return ord;
+}
+
+/// \brief Depth-first discovery (preorder) order
+/// \param g: compact graph
+/// \return compact states in the order of new numbers
+template<typename State>
+std::vector<atm_size> dfs_order(const compact_graph<State> &g) noexcept
+{
+    std::vector<atm_size> numbers(g.size(), UNNUMBERED), ord;
+    ord.reserve(g.size());
+    // <state, next successor index>
+    std::vector<std::pair<atm_size, std::size_t>> stack;
+
+    for_each_root(g, numbers, [&](const atm_size root)
+    {
+        numbers[root] = ord.size();
+        ord.push_back(root);
+        stack.emplace_back(root, g.offsets[root]);
+        while (!stack.empty())
+        {
+            auto& [q, next] = stack.back();
+            if (next == g.offsets[q + 1])
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            if (const auto r = g.successors[next++]; numbers[r] == UNNUMBERED)
+            {
+                numbers[r] = ord.size();
+                ord.push_back(r);
+                stack.emplace_back(r, g.offsets[r]);
+            }
+        }
+    });
+
+    return ord;
+}
+
+/// \brief Cuthill–McKee order over the undirected (symmetrized) graph
+/// \param g: compact graph
+/// \return compact states in the order of new numbers
+template<typename State>
+std::vector<atm_size> cuthill_mckee_order(const compact_graph<State> &g) noexcept
+{
+    // undirected adjacency: successors and predecessors
+    std::vector<std::size_t> offsets(g.size() + 1, 0);
+    for (atm_size q = 0; q < g.size(); ++q)
+        for (auto i = g.offsets[q]; i < g.offsets[q + 1]; ++i)
+        {
+            ++offsets[q + 1];
+            ++offsets[g.successors[i] + 1];
+        }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    std::vector<atm_size> neighbours(offsets.back());
+    for (atm_size q = 0; q < g.size(); ++q)
+        for (auto i = g.offsets[q]; i < g.offsets[q + 1]; ++i)
+        {
+            neighbours[fill[q]++] = g.successors[i];
+            neighbours[fill[g.successors[i]]++] = q;
+        }
+
+    auto degree = [&offsets](const atm_size q) { return offsets[q + 1] - offsets[q]; };
+    // neighbours are visited from the lowest degree
+    for (atm_size q = 0; q < g.size(); ++q)
+        std::sort(neighbours.begin() + offsets[q], neighbours.begin() + offsets[q + 1],
+                  [&degree](const atm_size a, const atm_size b) { return degree(a) < degree(b); });
+
+    std::vector<atm_size> numbers(g.size(), UNNUMBERED), ord;
+    ord.reserve(g.size());
+
+    for_each_root(g, numbers, [&](const atm_size root)
+    {
+        numbers[root] = ord.size();
+        ord.push_back(root);
+        // queue is the tail of @ord
+        for (std::size_t head = ord.size() - 1; head < ord.size(); ++head)
+            for (auto i = offsets[ord[head]]; i < offsets[ord[head] + 1]; ++i)
+                if (const auto r = neighbours[i]; numbers[r] == UNNUMBERED)
+                {
+                    numbers[r] = ord.size();
+                    ord.push_back(r);
+                }
+    });
+
+    return ord;
+}
+
+/// \brief Rebuild automaton parts over the new numbers
+/// \param automat: original automaton
+/// \param ord: numbering order
+/// \param make: constructor of the result automaton from (finals, offsets, successors) in new numbers
+/// \return renumbered automaton with the way back
+template<typename T, typename Automaton, typename Maker>
+renumbered<T> rebuild(const Automaton &automat, const order ord, Maker&& make) noexcept
+{
+    using State = typename Automaton::atm_size;
+    const auto g = build_compact(automat);
+
+    std::vector<atm_size> ordered;
+    switch (ord)
+    {
+        case order::bfs: ordered = bfs_order(g); break;
+        case order::dfs: ordered = dfs_order(g); break;
+        case order::cuthill_mckee: ordered = cuthill_mckee_order(g); break;
+    }
+
+    // new number for each compact state
+    std::vector<atm_size> numbers(g.size());
+    for (atm_size i = 0; i < ordered.size(); ++i)
+        numbers[ordered[i]] = i;
+
+    typename Automaton::finals_container finals;
+    finals.reserve(automat.get_final_num_sets());
+    for (const auto& set : automat.get_final_states())
+    {
+        auto& new_set = finals.emplace_back();
+        new_set.reserve(set.size());
+        for (const auto& state : set)
+            new_set.insert(numbers[g.compact(state)]);
+    }
+
+    // new rows one after another
+    typename basic_frozen_buchi<State>::offsets_container offsets{ 0 };
+    offsets.reserve(g.size() + 1);
+    typename basic_frozen_buchi<State>::csr_container successors;
+    successors.reserve(g.successors.size());
+    std::vector<State> origin(g.size());
+    for (atm_size i = 0; i < ordered.size(); ++i)
+    {
+        const auto q = ordered[i];
+        origin[i] = g.states[q];
+        for (auto j = g.offsets[q]; j < g.offsets[q + 1]; ++j)
+            successors.push_back(numbers[g.successors[j]]);
+        offsets.push_back(successors.size());
+    }
+
+    return { make(std::move(finals), std::move(offsets), std::move(successors)), std::move(origin) };
+}
+
+} // namespace anonymous
+
+template<typename State>
+renumbered<basic_buchi<State>> renumber(const basic_buchi<State> &automat, const order ord) noexcept
+{
+    return rebuild<basic_buchi<State>>(automat, ord, [](typename basic_buchi<State>::finals_container finals,
+            const typename basic_frozen_buchi<State>::offsets_container &offsets,
+            const typename basic_frozen_buchi<State>::csr_container &successors)
+    {
+        typename basic_buchi<State>::table_container table;
+        table.reserve(offsets.size());
+        for (std::size_t q = 0; q + 1 < offsets.size(); ++q)
+            if (offsets[q] != offsets[q + 1])
+                table[q].insert(successors.begin() + offsets[q], successors.begin() + offsets[q + 1]);
+
+        return basic_buchi<State>(std::move(finals), std::move(table));
+    });
+}
+
+template<typename State>
+renumbered<basic_frozen_buchi<State>> renumber(const basic_frozen_buchi<State> &automat, const order ord) noexcept
+{
+    return rebuild<basic_frozen_buchi<State>>(automat, ord, [](typename basic_frozen_buchi<State>::finals_container finals,
+            typename basic_frozen_buchi<State>::offsets_container offsets,
+            typename basic_frozen_buchi<State>::csr_container successors)
+    {
+        return basic_frozen_buchi<State>(std::move(finals), std::move(offsets), std::move(successors));
+    });
+}
+
+template<typename State>
+renumbered<basic_frozen_buchi<State>> renumber_frozen(const basic_buchi<State> &automat, const order ord) noexcept
+{
+    return rebuild<basic_frozen_buchi<State>>(automat, ord, [](typename basic_frozen_buchi<State>::finals_container finals,
+            typename basic_frozen_buchi<State>::offsets_container offsets,
+            typename basic_frozen_buchi<State>::csr_container successors)
+    {
+        return basic_frozen_buchi<State>(std::move(finals), std::move(offsets), std::move(successors));
+    });
+}
+
+template renumbered<basic_buchi<uint16_t>> renumber(const basic_buchi<uint16_t>&, order) noexcept;
+template renumbered<basic_buchi<uint32_t>> renumber(const basic_buchi<uint32_t>&, order) noexcept;
+template renumbered<basic_buchi<uint64_t>> renumber(const basic_buchi<uint64_t>&, order) noexcept;
+
+template renumbered<basic_frozen_buchi<uint16_t>> renumber(const basic_frozen_buchi<uint16_t>&, order) noexcept;
+template renumbered<basic_frozen_buchi<uint32_t>> renumber(const basic_frozen_buchi<uint32_t>&, order) noexcept;
+template renumbered<basic_frozen_buchi<uint64_t>> renumber(const basic_frozen_buchi<uint64_t>&, order) noexcept;
+
+template renumbered<basic_frozen_buchi<uint16_t>> renumber_frozen(const basic_buchi<uint16_t>&, order) noexcept;
+template renumbered<basic_frozen_buchi<uint32_t>> renumber_frozen(const basic_buchi<uint32_t>&, order) noexcept;
+template renumbered<basic_frozen_buchi<uint64_t>> renumber_frozen(const basic_buchi<uint64_t>&, order) noexcept;
+
+} // namespace utils::renumbering
@@ -1,8 +1,10 @@
 #include "utils/representation.hpp"
 
 #include "automates/buchi.hpp"
+#include "automates/frozen_buchi.hpp"
 
 #include <iostream>
+#include <limits>
 
 namespace utils::representation
 {
@@ -12,12 +14,14 @@ using namespace automates;
 namespace
 {
 /// \brief Read final states in format: sets num, {in_set_num, {num}x(in_set_num)}x(sets num)
+/// \param State: state type of the constructed automaton
 /// \param in: input stream
-/// \return container for final states (buchi::finals_container)
+/// \return container for final states (basic_acceptance::finals_container)
+template<typename State>
 auto read_final_states(std::istream &in) noexcept
 {
-    buchi::finals_container final_states;  // container for accept states
-    buchi::atm_size fs_num;    // number of sets
+    typename basic_acceptance<State>::finals_container final_states;  // container for accept states
+    std::size_t fs_num;    // number of sets
     // read number of sets
     if (&in == &std::cin)
         std::cout << "Enter number of final sets: ";
@@ -26,8 +30,8 @@ auto read_final_states(std::istream &in) noexcept
     final_states.reserve(fs_num);
     for (; fs_num; --fs_num)
     {
-        std::unordered_set<buchi::atm_size> final_states_in_set;   // container for one accept set with final states
-        buchi::atm_size fs_set; // number of elements in current set
+        std::unordered_set<State> final_states_in_set;   // container for one accept set with final states
+        std::size_t fs_set; // number of elements in current set
         if (&in == &std::cin)
             std::cout << "Enter amount of final states for new set: ";
         // read amount in current set
@@ -37,7 +41,7 @@ auto read_final_states(std::istream &in) noexcept
             std::cout << "Enter "<< fs_set << " numbers which will be your final states: ";
         for (; fs_set; --fs_set)
         {
-            buchi::atm_size x; // final state
+            State x; // final state
             // read final state
             in >> x;
             final_states_in_set.insert(x);
@@ -50,15 +54,15 @@ auto read_final_states(std::istream &in) noexcept
 }
 
 /// \brief Read input until EOF by two numbers: current state, acceptable state
+/// \param State: state type of the constructed automaton
 /// \param in: input stream
-/// \return container for final states (buchi::finals_container)
-auto read_transition_table(std::istream &in) noexcept
+/// \param on_edge: consumer of each read transition (current state, acceptable state)
+template<typename State, typename F>
+void read_transitions(std::istream &in, F&& on_edge) noexcept
 {
-    buchi::table_container table; // container for transition table
-
     const bool is_console = &in == &std::cin;
 
-    buchi::atm_size edges_num = 0;
+    std::size_t edges_num = 0;
     if (is_console)
     {
         std::cout << "Enter how many edges will be in your automaton: ";
@@ -70,44 +74,215 @@ auto read_transition_table(std::istream &in) noexcept
         if (is_console)
             std::cout << "Enter a pair of vertexes [from, to]: ";
         // read current state with acceptable new state
-        buchi::atm_size curr_st, next_st;
+        State curr_st, next_st;
         in >> curr_st >> next_st;
 
-        table[curr_st].insert(next_st);
+        on_edge(curr_st, next_st);
     }
+}
+
+/// \brief Read transition table (see @read_transitions)
+/// \param State: state type of the constructed automaton
+/// \param in: input stream
+/// \param resource: memory resource for the table nodes
+/// \return container for transition table (basic_buchi::table_container)
+template<typename State>
+auto read_transition_table(std::istream &in, std::pmr::memory_resource *resource) noexcept
+{
+    typename basic_buchi<State>::table_container table(resource); // container for transition table
+    read_transitions<State>(in, [&table](const State from, const State to) { table[from].insert(to); });
 
     return std::move(table);
 }
 
+/// \brief Read transitions list (see @read_transitions)
+/// \param State: state type of the constructed automaton
+/// \param in: input stream
+/// \return container for transitions (basic_frozen_buchi::edges_container)
+template<typename State>
+auto read_edges(std::istream &in) noexcept
+{
+    typename basic_frozen_buchi<State>::edges_container edges; // container for transitions
+    read_transitions<State>(in, [&edges](const State from, const State to) { edges.emplace_back(from, to); });
+
+    return std::move(edges);
+}
+
+/// \typedef Final states read in the widest type
+using wide_finals = basic_acceptance<uint64_t>::finals_container;
+/// \typedef Transitions read in the widest type
+using wide_edges = basic_frozen_buchi<uint64_t>::edges_container;
+
+/// \brief Smallest state type that fits the read states
+/// \param finals: final states in the widest type
+/// \param edges: transitions in the widest type
+/// \param degeneralized: the type must also fit the states of the automaton converted to NBA
+/// \return number of bits of the type: 16, 32 or 64
+unsigned fitting_bits(const wide_finals &finals, const wide_edges &edges, const bool degeneralized) noexcept
+{
+    uint64_t max_state = basic_acceptance<uint64_t>::INITIAL_STATE;
+    for (const auto& set : finals)
+        for (const auto& state : set)
+            max_state = std::max(max_state, state);
+    for (const auto& [from, to] : edges)
+        max_state = std::max({ max_state, from, to });
+
+    /// \note NGA-to-NBA conversion multiplies the states by the number of the final sets, and the maximal value of
+    ///     the type marks the unvisited states there. So the type must number all paired states below its maximum
+    const uint64_t sets_num = degeneralized ? std::max<uint64_t>(finals.size(), 1) : 1;
+    const bool overflow = max_state >= std::numeric_limits<uint64_t>::max() / sets_num;
+    const uint64_t bound = overflow ? std::numeric_limits<uint64_t>::max() : (max_state + 1) * sets_num;
+
+    if (bound <= std::numeric_limits<uint16_t>::max())
+        return 16;
+    if (bound <= std::numeric_limits<uint32_t>::max())
+        return 32;
+
+    return 64;
+}
+
+/// \brief Narrow final states read in the widest type into the selected state type
+/// \param State: state type of the constructed automaton. All states must fit
+/// \param finals: final states in the widest type
+/// \return final states container
+template<typename State>
+typename basic_acceptance<State>::finals_container narrow_finals(const wide_finals &finals) noexcept
+{
+    typename basic_acceptance<State>::finals_container narrow;
+    narrow.reserve(finals.size());
+    for (const auto& set : finals)
+        narrow.emplace_back(set.begin(), set.end());
+
+    return narrow;
+}
+
+/// \brief Build hashed automaton from the read in the widest type parts in the selected state type
+/// \param State: state type of the constructed automaton. All states must fit
+/// \param finals: final states in the widest type
+/// \param edges: transitions in the widest type
+/// \return constructed automaton
+template<typename State>
+basic_buchi<State> narrow_hashed(const wide_finals &finals, const wide_edges &edges) noexcept
+{
+    typename basic_buchi<State>::table_container table;
+    for (const auto& [from, to] : edges)
+        table[from].insert(to);
+
+    return basic_buchi<State>(narrow_finals<State>(finals), std::move(table));
+}
+
+/// \brief Narrow read in the widest type automaton parts into the selected state type
+/// \param State: state type of the constructed automaton. All states must fit
+/// \param finals: final states in the widest type
+/// \param edges: transitions in the widest type
+/// \return constructed automaton
+template<typename State>
+basic_frozen_buchi<State> narrow(const wide_finals &finals, const wide_edges &edges) noexcept
+{
+    typename basic_frozen_buchi<State>::edges_container narrow_edges;
+    narrow_edges.reserve(edges.size());
+    for (const auto& [from, to] : edges)
+        narrow_edges.emplace_back(from, to);
+
+    return basic_frozen_buchi<State>(narrow_finals<State>(finals), std::move(narrow_edges));
+}
+
 } // namespace anonymous
 
-buchi construct_read(std::istream &in) noexcept
+template<typename State>
+basic_buchi<State> construct_read(std::istream &in, const construction mode) noexcept
 {
     // container for accept states
-    auto final_states = read_final_states(in);
+    auto final_states = read_final_states<State>(in);
     // container for transition table
-    auto table = read_transition_table(in);
+    auto arena = make_arena(mode);
+    auto table = read_transition_table<State>(in, resource_of(arena));
+
+    return basic_buchi<State>(std::move(final_states), std::move(table), std::move(arena));
+}
+
+template<typename State>
+basic_frozen_buchi<State> construct_read_frozen(std::istream &in) noexcept
+{
+    // container for accept states
+    auto final_states = read_final_states<State>(in);
+    // transitions go straight into the CSR arrays
+    auto edges = read_edges<State>(in);
 
-    return buchi(std::move(final_states), std::move(table));
+    return basic_frozen_buchi<State>(std::move(final_states), std::move(edges));
 }
 
+fitted_frozen_buchi construct_read_fitted(std::istream &in, const bool degeneralized) noexcept
+{
+    // read in the widest type
+    auto final_states = read_final_states<uint64_t>(in);
+    auto edges = read_edges<uint64_t>(in);
+
+    // the smallest type that fits
+    switch (fitting_bits(final_states, edges, degeneralized))
+    {
+        case 16: return narrow<uint16_t>(final_states, edges);
+        case 32: return narrow<uint32_t>(final_states, edges);
+        default: return basic_frozen_buchi<uint64_t>(std::move(final_states), std::move(edges));
+    }
+}
+
+fitted_buchi construct_read_fitted_hashed(std::istream &in, const bool degeneralized) noexcept
+{
+    // read in the widest type: the transitions list is hashed once in the fitted type
+    const auto final_states = read_final_states<uint64_t>(in);
+    const auto edges = read_edges<uint64_t>(in);
+
+    // the smallest type that fits
+    switch (fitting_bits(final_states, edges, degeneralized))
+    {
+        case 16: return narrow_hashed<uint16_t>(final_states, edges);
+        case 32: return narrow_hashed<uint32_t>(final_states, edges);
+        default: return narrow_hashed<uint64_t>(final_states, edges);
+    }
+}
+
+template basic_buchi<uint16_t> construct_read(std::istream &in, construction mode) noexcept;
+template basic_buchi<uint32_t> construct_read(std::istream &in, construction mode) noexcept;
+template basic_buchi<uint64_t> construct_read(std::istream &in, construction mode) noexcept;
+
+template basic_frozen_buchi<uint16_t> construct_read_frozen(std::istream &in) noexcept;
+template basic_frozen_buchi<uint32_t> construct_read_frozen(std::istream &in) noexcept;
+template basic_frozen_buchi<uint64_t> construct_read_frozen(std::istream &in) noexcept;
+
 } // namespace utils::representation
 
 namespace automates
 {
-/// \note: Similar to user input
-std::ostream& operator<<(std::ostream &out, const buchi &automaton)
+/// \namespace Anonymous namespace. Helpers with printing automaton parts
+namespace
+{
+
+/// \brief Print final states sets: number of sets, then number in set with its states for each set
+/// \param out: output stream
+/// \param finals: final states container
+template<typename State>
+void print_finals(std::ostream &out, const typename basic_acceptance<State>::finals_container &finals)
 {
     // print number of sets
-    out << automaton.m_final_states.size() << "\n";
+    out << finals.size() << "\n";
     // print final sets
-    for (size_t i = 0; i < automaton.m_final_states.size(); ++i, out << '\n')
+    for (size_t i = 0; i < finals.size(); ++i, out << '\n')
     {
         // print number in set
-        out << automaton.m_final_states[i].size() << " ";
-        for (const auto &it : automaton.m_final_states[i])
+        out << finals[i].size() << " ";
+        for (const auto &it : finals[i])
             out << it << " ";
     }
+}
+
+} // namespace anonymous
+
+/// \note: Similar to user input
+template<typename State>
+std::ostream& operator<<(std::ostream &out, const basic_buchi<State> &automaton)
+{
+    print_finals<State>(out, automaton.get_final_states());
 
     // print transition table
     for (const auto&[from, set] : automaton.m_trans_table)
@@ -117,4 +292,26 @@ std::ostream& operator<<(std::ostream &out, const buchi &automaton)
     return out;
 }
 
+/// \note: Similar to user input
+template<typename State>
+std::ostream& operator<<(std::ostream &out, const basic_frozen_buchi<State> &automaton)
+{
+    print_finals<State>(out, automaton.get_final_states());
+
+    // print transition table row by row
+    for (std::size_t from = 0; from < automaton.get_states_bound(); ++from)
+        for (const auto& to : automaton.successors(from))
+            out << from << " " << to << '\n';
+
+    return out;
+}
+
+template std::ostream& operator<<(std::ostream &out, const basic_buchi<uint16_t> &automaton);
+template std::ostream& operator<<(std::ostream &out, const basic_buchi<uint32_t> &automaton);
+template std::ostream& operator<<(std::ostream &out, const basic_buchi<uint64_t> &automaton);
+
+template std::ostream& operator<<(std::ostream &out, const basic_frozen_buchi<uint16_t> &automaton);
+template std::ostream& operator<<(std::ostream &out, const basic_frozen_buchi<uint32_t> &automaton);
+template std::ostream& operator<<(std::ostream &out, const basic_frozen_buchi<uint64_t> &automaton);
+
 } // namespace automates
@@ -0,0 +1,159 @@
+#include "batch.hpp"
+
+#include "dfs/two_stack.hpp"
+#include "parallel/pool.hpp"
+
+#include <fstream>
+#include <future>
+#include <memory_resource>
+#include <variant>
+
+namespace emptiness_check::batch
+{
+
+/// \namespace Anonymous namespace. Helpers with the per-worker scheduling
+namespace
+{
+
+/// \struct Per-worker counters and scratch memory
+struct alignas(64) worker_slot
+{
+    /// \brief number of the done checks
+    std::size_t checks = 0;
+    /// \brief peak scratch bytes among the checks
+    std::size_t scratch_peak = 0;
+    /// \brief scratch memory of the checks. Keeps the released blocks for the next check
+    std::pmr::unsynchronized_pool_resource scratch = {};
+};
+
+/// \brief Default check of the frozen automaton
+/// \param automat: checked automaton
+/// \param scratch: scratch memory of the worker
+/// \param scratch_peak: peak scratch bytes
+/// \return true if the automaton is empty
+template<typename State>
+bool two_stack_check(const automates::basic_frozen_buchi<State> &automat, std::pmr::memory_resource *scratch,
+                     std::size_t *scratch_peak) noexcept
+{
+    return dfs::two_stack::is_empty(automat, scratch_peak, scratch);
+}
+
+/// \overload
+bool two_stack_check(const utils::representation::fitted_frozen_buchi &automat, std::pmr::memory_resource *scratch,
+                     std::size_t *scratch_peak) noexcept
+{
+    return std::visit([scratch, scratch_peak](const auto &at)
+                      { return dfs::two_stack::is_empty(at, scratch_peak, scratch); }, automat);
+}
+
+/// \brief Check the range of the automata and store the results
+/// \param workers: thread pool
+/// \param size: number of the automata
+/// \param get: accessor of the automaton by its index (nullptr for the missed one)
+/// \param fn: check of one automaton (two-stack if empty)
+/// \param[out] results: results of the range
+/// \param[in, out] slots: per-worker counters and scratch memory
+template<typename T, typename Get>
+void check_range(parallel::pool &workers, const std::size_t size, Get &&get, const check_fn<T> &fn,
+                 std::optional<bool> *results, std::vector<worker_slot> &slots) noexcept
+{
+    parallel::for_each_stealing(workers, size, [&](const std::size_t i, const unsigned id)
+    {
+        const T *automat = get(i);
+        if (!automat)
+            return;
+
+        auto& slot = slots[id];
+        std::size_t scratch = 0;
+        results[i] = fn ? fn(*automat, &slot.scratch, &scratch) : two_stack_check(*automat, &slot.scratch, &scratch);
+        ++slot.checks;
+        slot.scratch_peak = std::max(slot.scratch_peak, scratch);
+    });
+}
+
+/// \brief Collect per-worker counters into the report
+/// \param slots: per-worker counters
+/// \param[out] result: report
+void summarize(const std::vector<worker_slot> &slots, report &result) noexcept
+{
+    for (const auto& slot : slots)
+    {
+        result.checks.push_back(slot.checks);
+        result.scratch_peak.push_back(slot.scratch_peak);
+    }
+}
+
+} // namespace anonymous
+
+template<typename T>
+report check(const std::span<const T> automata, const check_fn<T> &fn, const unsigned threads) noexcept
+{
+    parallel::pool workers(threads);
+    std::vector<worker_slot> slots(workers.size());
+
+    report result;
+    result.results.resize(automata.size());
+    check_range<T>(workers, automata.size(), [&automata](const std::size_t i) { return &automata[i]; }, fn,
+                   result.results.data(), slots);
+    summarize(slots, result);
+
+    return result;
+}
+
+report check(const std::vector<std::string> &paths,
+             const check_fn<utils::representation::fitted_frozen_buchi> &fn,
+             const unsigned threads, std::size_t window, const bool degeneralized) noexcept
+{
+    using automaton = utils::representation::fitted_frozen_buchi;
+    using window_container = std::vector<std::optional<automaton>>;
+
+    parallel::pool workers(threads);
+    std::vector<worker_slot> slots(workers.size());
+    if (!window)
+        window = 4 * static_cast<std::size_t>(workers.size());
+
+    auto read = [&paths, degeneralized](const std::size_t begin, const std::size_t end)
+    {
+        window_container automata;
+        automata.reserve(end - begin);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            std::ifstream fs(paths[i], std::fstream::in);
+            if (fs.is_open())
+                automata.emplace_back(utils::representation::construct_read_fitted(fs, degeneralized));
+            else
+                automata.emplace_back(std::nullopt);
+        }
+
+        return automata;
+    };
+
+    report result;
+    result.results.resize(paths.size());
+    auto next = std::async(std::launch::async, read, std::size_t{0}, std::min(window, paths.size()));
+    for (std::size_t begin = 0; begin < paths.size(); begin += window)
+    {
+        const auto current = next.get();
+        // read ahead while the current window is checked
+        if (const auto end = begin + window; end < paths.size())
+            next = std::async(std::launch::async, read, end, std::min(end + window, paths.size()));
+
+        check_range<automaton>(workers, current.size(), [&current](const std::size_t i)
+                               { return current[i] ? &*current[i] : nullptr; }, fn,
+                               result.results.data() + begin, slots);
+    }
+    summarize(slots, result);
+
+    return result;
+}
+
+template report check(std::span<const automates::basic_frozen_buchi<uint16_t>>,
+                      const check_fn<automates::basic_frozen_buchi<uint16_t>>&, unsigned) noexcept;
+template report check(std::span<const automates::basic_frozen_buchi<uint32_t>>,
+                      const check_fn<automates::basic_frozen_buchi<uint32_t>>&, unsigned) noexcept;
+template report check(std::span<const automates::basic_frozen_buchi<uint64_t>>,
+                      const check_fn<automates::basic_frozen_buchi<uint64_t>>&, unsigned) noexcept;
+template report check(std::span<const utils::representation::fitted_frozen_buchi>,
+                      const check_fn<utils::representation::fitted_frozen_buchi>&, unsigned) noexcept;
+
+} // namespace emptiness_check::batch
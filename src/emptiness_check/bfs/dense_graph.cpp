@@ -0,0 +1,107 @@
+#include "bfs/dense_graph.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace emptiness_check::bfs
+{
+
+template<typename State>
+dense_graph<State> build_dense_graph(const automates::basic_inv_buchi<State> &automat,
+                                     std::size_t &index_bytes) noexcept
+{
+    dense_graph<State> graph;
+    std::unordered_map<State, std::size_t> index;
+
+    graph.states.push_back(automates::basic_inv_buchi<State>::INITIAL_STATE);
+    index.emplace(graph.states.front(), 0);
+    // BFS queue is the tail of the states. Rows are filled in the discovery order
+    for (std::size_t head = 0; head < graph.states.size(); ++head)
+    {
+        for (const auto& qt : automat.successors(graph.states[head]))
+        {
+            const auto [it, inserted] = index.try_emplace(qt, graph.states.size());
+            if (inserted)
+                graph.states.push_back(qt);
+            graph.succs.targets.push_back(it->second);
+        }
+        graph.succs.offsets.push_back(graph.succs.targets.size());
+    }
+
+    // backward steps restricted to the reachable states
+    graph.preds.offsets.reserve(graph.states.size() + 1);
+    for (const auto& q : graph.states)
+    {
+        if (auto inv = automat.acceptable_inv_transitions(q))
+            for (const auto& p : (*inv)->second)
+                if (auto it = index.find(p); it != index.end())
+                    graph.preds.targets.push_back(it->second);
+        graph.preds.offsets.push_back(graph.preds.targets.size());
+    }
+
+    index_bytes = automates::memory::hashed_bytes(index);
+    return graph;
+}
+
+template<typename State>
+dense_graph<State> build_dense_graph(const automates::basic_frozen_buchi<State> &automat,
+                                     std::size_t &index_bytes) noexcept
+{
+    constexpr std::size_t UNINDEXED = std::numeric_limits<std::size_t>::max();
+    dense_graph<State> graph;
+
+    // successors may lie above the rows bound (states without outgoing transitions)
+    std::size_t bound = automat.get_states_bound();
+    for (std::size_t q = 0; q < automat.get_states_bound(); ++q)
+        for (const auto& qt : automat.successors(q))
+            bound = std::max<std::size_t>(bound, static_cast<std::size_t>(qt) + 1);
+    std::vector<std::size_t> index(bound, UNINDEXED);
+
+    graph.states.push_back(automates::basic_frozen_buchi<State>::INITIAL_STATE);
+    index[graph.states.front()] = 0;
+    // BFS queue is the tail of the states. Rows are filled in the discovery order
+    for (std::size_t head = 0; head < graph.states.size(); ++head)
+    {
+        for (const auto& qt : automat.successors(graph.states[head]))
+        {
+            if (index[qt] == UNINDEXED)
+            {
+                index[qt] = graph.states.size();
+                graph.states.push_back(qt);
+            }
+            graph.succs.targets.push_back(index[qt]);
+        }
+        graph.succs.offsets.push_back(graph.succs.targets.size());
+    }
+
+    // backward rows: count predecessors per row and then shift them into the offsets
+    const std::size_t n = graph.states.size();
+    graph.preds.offsets.assign(n + 1, 0);
+    for (const auto& v : graph.succs.targets)
+        ++graph.preds.offsets[v + 1];
+    std::partial_sum(graph.preds.offsets.begin(), graph.preds.offsets.end(), graph.preds.offsets.begin());
+
+    std::vector<std::size_t> fill(graph.preds.offsets.begin(), graph.preds.offsets.end() - 1);
+    graph.preds.targets.resize(graph.succs.targets.size());
+    for (std::size_t u = 0; u < n; ++u)
+        for (auto j = graph.succs.offsets[u]; j < graph.succs.offsets[u + 1]; ++j)
+            graph.preds.targets[fill[graph.succs.targets[j]]++] = u;
+
+    index_bytes = automates::memory::vector_bytes(index) + automates::memory::vector_bytes(fill);
+    return graph;
+}
+
+template dense_graph<uint16_t> build_dense_graph(const automates::basic_inv_buchi<uint16_t>&, std::size_t&) noexcept;
+template dense_graph<uint32_t> build_dense_graph(const automates::basic_inv_buchi<uint32_t>&, std::size_t&) noexcept;
+template dense_graph<uint64_t> build_dense_graph(const automates::basic_inv_buchi<uint64_t>&, std::size_t&) noexcept;
+
+template dense_graph<uint16_t> build_dense_graph(const automates::basic_frozen_buchi<uint16_t>&,
+                                                 std::size_t&) noexcept;
+template dense_graph<uint32_t> build_dense_graph(const automates::basic_frozen_buchi<uint32_t>&,
+                                                 std::size_t&) noexcept;
+template dense_graph<uint64_t> build_dense_graph(const automates::basic_frozen_buchi<uint64_t>&,
+                                                 std::size_t&) noexcept;
+
+} // namespace emptiness_check::bfs
@@ -0,0 +1,181 @@
+#include "bfs/direction.hpp"
+
+#include "automates/memory.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace emptiness_check::bfs::direction
+{
+
+/// \namespace Anonymous namespace. Direction switching parameters
+namespace
+{
+
+/// \brief Number of the items processed by a worker at once
+constexpr std::size_t CHUNK = 1024;
+/// \brief Go bottom-up when the frontier rows exceed 1/ALPHA of the unreached rows
+constexpr std::size_t ALPHA = 14;
+/// \brief Go top-down when the frontier is smaller than 1/BETA of the states
+constexpr std::size_t BETA = 24;
+
+/// \brief Check if the step stays inside the class
+/// \param colors: optional partition of the states
+/// \param u: step source
+/// \param v: step target
+/// \return true without the partition or for the same colors
+inline bool same_class(const std::vector<std::size_t> *colors, const std::size_t u, const std::size_t v) noexcept
+{
+    return !colors || (*colors)[u] == (*colors)[v];
+}
+
+} // namespace anonymous
+
+std::size_t adjacency::bytes() const noexcept
+{
+    return automates::memory::vector_bytes(offsets) + automates::memory::vector_bytes(targets);
+}
+
+engine::engine(const std::size_t states_num, const unsigned workers_num) noexcept
+    : m_reach(states_num), m_frontier_bits(states_num), m_next_bits(states_num), m_outputs(workers_num),
+      m_states_num(states_num)
+{}
+
+void engine::top_down(const adjacency &push, const adjacency &pull, const std::vector<char> &allowed,
+                      parallel::pool &workers, const std::vector<std::size_t> *colors) noexcept
+{
+    parallel::for_each_chunk(workers, m_frontier.size(), CHUNK,
+        [&](const std::size_t begin, const std::size_t end, const unsigned id)
+        {
+            auto& out = m_outputs[id];
+            for (std::size_t f = begin; f < end; ++f)
+            {
+                const auto u = m_frontier[f];
+                out.inspected += push.degree(u);
+                for (std::size_t j = push.offsets[u]; j < push.offsets[u + 1]; ++j)
+                    if (const auto p = push.targets[j]; allowed[p] && same_class(colors, u, p) && m_reach.set(p))
+                    {
+                        out.found.push_back(p);
+                        out.found_degree += push.degree(p);
+                        out.found_pull_degree += pull.degree(p);
+                    }
+            }
+            out.found_num = out.found.size();
+        });
+}
+
+void engine::bottom_up(const adjacency &push, const adjacency &pull, const std::vector<char> &allowed,
+                       parallel::pool &workers, const std::vector<std::size_t> *colors) noexcept
+{
+    parallel::for_each_chunk(workers, m_states_num, CHUNK,
+        [&](const std::size_t begin, const std::size_t end, const unsigned id)
+        {
+            auto& out = m_outputs[id];
+            for (std::size_t v = begin; v < end; ++v)
+            {
+                if (!allowed[v] || m_reach.test(v))
+                    continue;
+
+                // stop at the first neighbour in the frontier: the main saving of the bottom-up level
+                for (std::size_t j = pull.offsets[v]; j < pull.offsets[v + 1]; ++j)
+                {
+                    ++out.inspected;
+                    if (const auto p = pull.targets[j]; m_frontier_bits.test(p) && same_class(colors, v, p))
+                    {
+                        m_reach.set(v);
+                        m_next_bits.set(v);
+                        ++out.found_num;
+                        out.found_degree += push.degree(v);
+                        out.found_pull_degree += pull.degree(v);
+                        break;
+                    }
+                }
+            }
+        });
+}
+
+void engine::run(const adjacency &push, const adjacency &pull, const std::vector<char> &allowed,
+                 const std::vector<std::size_t> &sources, parallel::pool &workers,
+                 const std::vector<std::size_t> *colors) noexcept
+{
+    m_reach.clear();
+    m_frontier.assign(sources.begin(), sources.end());
+
+    // rows of the frontier and of the not yet reached states drive the direction
+    std::size_t frontier_num = m_frontier.size(), frontier_edges = 0, unreached_edges = 0;
+    for (const auto v : m_frontier)
+        frontier_edges += push.degree(v);
+    m_top_down += frontier_edges;
+    for (auto& out : m_outputs)
+        out.found_pull_degree = 0;
+    parallel::for_each_chunk(workers, m_states_num, CHUNK,
+        [&](const std::size_t begin, const std::size_t end, const unsigned id)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+                if (allowed[v])
+                    m_outputs[id].found_pull_degree += pull.degree(v);
+        });
+    for (const auto& out : m_outputs)
+        unreached_edges += out.found_pull_degree;
+
+    bool bottom = false;
+    while (frontier_num)
+    {
+        if (!bottom && frontier_edges > unreached_edges / ALPHA)
+        {
+            // sparse frontier -> bitmap
+            bottom = true;
+            m_frontier_bits.clear();
+            for (const auto v : m_frontier)
+                m_frontier_bits.set(v);
+        }
+        else if (bottom && frontier_num < m_states_num / BETA)
+        {
+            // bitmap -> sparse frontier
+            bottom = false;
+            m_frontier.clear();
+            for (std::size_t v = 0; v < m_states_num; ++v)
+                if (m_frontier_bits.test(v))
+                    m_frontier.push_back(v);
+        }
+
+        for (auto& out : m_outputs)
+            out = worker_output{ .found = std::move(out.found) };
+        if (bottom)
+            bottom_up(push, pull, allowed, workers, colors);
+        else
+            top_down(push, pull, allowed, workers, colors);
+
+        frontier_num = frontier_edges = 0;
+        if (!bottom)
+            m_frontier.clear();
+        for (auto& out : m_outputs)
+        {
+            frontier_num += out.found_num;
+            frontier_edges += out.found_degree;
+            unreached_edges -= std::min(unreached_edges, out.found_pull_degree);
+            m_inspected += out.inspected;
+            m_top_down += out.found_degree;
+            m_frontier.insert(m_frontier.end(), out.found.begin(), out.found.end());
+            out.found.clear();
+        }
+
+        if (bottom)
+        {
+            std::swap(m_frontier_bits, m_next_bits);
+            m_next_bits.clear();
+        }
+    }
+}
+
+std::size_t engine::bytes() const noexcept
+{
+    std::size_t bytes = m_reach.bytes() + m_frontier_bits.bytes() + m_next_bits.bytes() +
+                        automates::memory::vector_bytes(m_frontier) + automates::memory::vector_bytes(m_outputs);
+    for (const auto& out : m_outputs)
+        bytes += automates::memory::vector_bytes(out.found);
+
+    return bytes;
+}
+
+} // namespace emptiness_check::bfs::direction
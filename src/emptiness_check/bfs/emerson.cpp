@@ -1,11 +1,167 @@
 #include "bfs/emerson.hpp"
+#include "bfs/dense_graph.hpp"
+
+#include <numeric>
+#include <vector>
 
 namespace emptiness_check::bfs::emerson
 {
 
-bool is_empty(const automates::inv_buchi &automat) noexcept
+/// \namespace Anonymous namespace. Helpers with set-based steps
+namespace
+{
+
+/// \struct Reused buffers of the backward searches
+struct backward_search
+{
+    /// \brief Create buffers for the states and workers
+    /// \param states_num: number of the dense states
+    /// \param workers_num: number of the workers
+    backward_search(const std::size_t states_num, const unsigned workers_num) noexcept
+        : reach(states_num, workers_num), buffers(workers_num), removed(workers_num, 0)
+    {}
+
+    /// \brief direction-optimizing search engine
+    direction::engine reach;
+    /// \brief states the search starts from
+    std::vector<std::size_t> targets = {};
+    /// \brief per-worker targets
+    std::vector<std::vector<std::size_t>> buffers;
+    /// \brief per-worker number of the pruned states
+    std::vector<std::size_t> removed;
+
+    /// \brief Bytes of the buffers
+    /// \note Storage is never shrunk: peak bytes
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        std::size_t bytes = reach.bytes() + automates::memory::vector_bytes(targets) +
+                            automates::memory::vector_bytes(buffers) + automates::memory::vector_bytes(removed);
+        for (const auto& buffer : buffers)
+            bytes += automates::memory::vector_bytes(buffer);
+
+        return bytes;
+    }
+};
+
+/// \brief Number of the items processed by a worker at once
+constexpr std::size_t CHUNK = 1024;
+
+/// \brief Keep in Z only states that reach (in one or more steps inside Z) a state of Z ∩ Fi
+/// \details The backward search pushes along the inverse transitions and pulls along the forward ones
+/// \param State: state type of the automaton
+/// \param graph: dense reachable graph
+/// \param automat: investigated automaton
+/// \param i: final set index
+/// \param[in,out] Z: current approximation of the states with an accepting run
+/// \param[in,out] search: reused buffers
+/// \param workers: thread pool
+/// \return number of the removed states
+template<typename State>
+std::size_t restrict_to_set(const dense_graph<State> &graph, const automates::basic_acceptance<State> &automat,
+                            const std::size_t i, std::vector<char> &Z, backward_search &search,
+                            parallel::pool &workers) noexcept
+{
+    auto& [reach, targets, buffers, removed] = search;
+    const std::size_t n = graph.states.size();
+
+    // targets: Z ∩ Fi
+    parallel::for_each_chunk(workers, n, CHUNK,
+        [&](const std::size_t begin, const std::size_t end, const unsigned id)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+                if (Z[v] && automat.is_final(graph.states[v], i))
+                    buffers[id].push_back(v);
+        });
+    targets.clear();
+    for (auto& buffer : buffers)
+    {
+        targets.insert(targets.end(), buffer.begin(), buffer.end());
+        buffer.clear();
+    }
+
+    // targets are marked only when reached themselves (cycle)
+    reach.run(graph.preds, graph.succs, Z, targets, workers);
+
+    std::fill(removed.begin(), removed.end(), 0);
+    parallel::for_each_chunk(workers, n, CHUNK,
+        [&](const std::size_t begin, const std::size_t end, const unsigned id)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+                if (Z[v] && !reach.reached(v))
+                {
+                    Z[v] = 0;
+                    ++removed[id];
+                }
+        });
+
+    return std::accumulate(removed.begin(), removed.end(), std::size_t{0});
+}
+
+/// \brief Emerson–Lei fixpoint over the dense reachable graph (see @is_empty)
+/// \param Automaton: investigated automaton type (with the inverse or the frozen transition table)
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures (if requested)
+/// \param threads: number of the worker threads
+/// \param[out] edges: inspected edges of all backward searches (if requested)
+/// \return false if it finds at least one (first) lasso
+template<typename Automaton>
+bool run(const Automaton &automat, std::size_t *scratch_peak, const unsigned threads, edges_report *edges) noexcept
+{
+    std::size_t index_bytes = 0;
+    const auto graph = build_dense_graph(automat, index_bytes);
+    const std::size_t n = graph.states.size();
+
+    // νZ. ∩i pre+(Z ∩ Fi): start from all reachable states and prune until nothing changes
+    parallel::pool workers(threads);
+    std::vector<char> Z(n, 1);
+    backward_search search(n, workers.size());
+    std::size_t alive = n;
+    for (bool changed = true; changed && alive;)
+    {
+        changed = false;
+        for (std::size_t i = 0; i < automat.get_final_num_sets() && alive; ++i)
+            if (const auto removed = restrict_to_set(graph, automat, i, Z, search, workers))
+            {
+                alive -= removed;
+                changed = true;
+            }
+    }
+
+    if (scratch_peak)
+        *scratch_peak = index_bytes + graph.bytes() + automates::memory::vector_bytes(Z) + search.bytes();
+    if (edges)
+        *edges = { .inspected = search.reach.inspected_edges(), .top_down = search.reach.top_down_edges() };
+
+    // every remaining state lies on (or leads inside Z to) a cycle visiting all final sets
+    return !alive;
+}
+
+} // namespace anonymous
+
+template<typename State>
+bool is_empty(const automates::basic_inv_buchi<State> &automat, std::size_t *scratch_peak,
+              const unsigned threads, edges_report *edges) noexcept
+{
+    return run(automat, scratch_peak, threads, edges);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak,
+              const unsigned threads, edges_report *edges) noexcept
 {
-    return automat.is_generalized();
+    return run(automat, scratch_peak, threads, edges);
 }
 
-} // namespace emptiness_check::dfs::emerson
+template bool is_empty(const automates::basic_inv_buchi<uint16_t>&, std::size_t*, unsigned, edges_report*) noexcept;
+template bool is_empty(const automates::basic_inv_buchi<uint32_t>&, std::size_t*, unsigned, edges_report*) noexcept;
+template bool is_empty(const automates::basic_inv_buchi<uint64_t>&, std::size_t*, unsigned, edges_report*) noexcept;
+
+template bool is_empty(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*, unsigned,
+                       edges_report*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*, unsigned,
+                       edges_report*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*, unsigned,
+                       edges_report*) noexcept;
+
+} // namespace emptiness_check::bfs::emerson
\ No newline at end of file
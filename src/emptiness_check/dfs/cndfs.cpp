@@ -0,0 +1,267 @@
+#include "dfs/cndfs.hpp"
+#include "dfs/frame.hpp"
+#include "automates/acceptance.hpp"
+
+#include "parallel/pool.hpp"
+#include "parallel/atomic_bitset.hpp"
+#include "utils/renumbering.hpp"
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <cassert>
+
+namespace emptiness_check::dfs::cndfs
+{
+
+/// \namespace Anonymous namespace. Helpers with the worker searches
+namespace
+{
+
+/// \class Worker-local bit array over the dense states
+class bit_array
+{
+public:
+    /// \brief Create cleared bits
+    /// \param size: number of the bits
+    explicit bit_array(const std::size_t size) noexcept
+        : m_words((size + WORD_BITS - 1) / WORD_BITS, 0)
+    {}
+
+    /// \brief Check the bit
+    /// \param i: bit index
+    /// \return true if the bit is set
+    [[nodiscard]] bool test(const std::size_t i) const noexcept { return m_words[i / WORD_BITS] & bit(i); }
+
+    /// \brief Set the bit
+    /// \param i: bit index
+    void set(const std::size_t i) noexcept { m_words[i / WORD_BITS] |= bit(i); }
+
+    /// \brief Clear the bit
+    /// \param i: bit index
+    void reset(const std::size_t i) noexcept { m_words[i / WORD_BITS] &= ~bit(i); }
+
+    /// \brief Bytes of the storage
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept { return automates::memory::vector_bytes(m_words); }
+
+private:
+    /// \brief bits in one storage word
+    static constexpr std::size_t WORD_BITS = automates::mask::WORD_BITS;
+
+    /// \brief Mask of the bit in its word
+    /// \param i: bit index
+    /// \return word with the one set bit
+    static automates::mask::word bit(const std::size_t i) noexcept
+    {
+        return automates::mask::word{1} << (i % WORD_BITS);
+    }
+
+    /// \brief bits storage
+    std::vector<automates::mask::word> m_words;
+};
+
+/// \struct Colors shared by all workers
+struct shared_colors
+{
+    /// \brief Create uncolored states
+    /// \param states_num: exclusive upper bound of the state numbers
+    explicit shared_colors(const std::size_t states_num) noexcept : blue(states_num), red(states_num) {}
+
+    /// \brief states explored by some blue search
+    parallel::atomic_bitset blue;
+    /// \brief states checked by some finished red search
+    parallel::atomic_bitset red;
+    /// \brief set by the worker that finds the lasso
+    std::atomic<bool> cancelled = false;
+};
+
+/// \class One CNDFS worker: the nested DFS in its own successors order over the shared colors
+/// \param State: state type of the automaton
+template<typename State>
+class worker
+{
+public:
+    /// \typedef Investigated automaton representation
+    using automaton = automates::basic_frozen_buchi<State>;
+
+    /// \brief Create the worker
+    /// \param automat: investigated automaton
+    /// \param colors: shared colors
+    /// \param seed: successors order seed
+    worker(const automaton &automat, shared_colors &colors, const std::size_t seed) noexcept
+        : m_automat(automat), m_colors(colors), m_order(seed),
+          m_cyan(automat.get_states_bound()), m_pink(automat.get_states_bound())
+    {}
+
+    /// \brief Blue search from the initial state
+    /// \return false if it finds at least one (first) lasso. Interrupted search returns true
+    bool run() noexcept
+    {
+        auto enter = [this](const State s)
+        {
+            m_cyan.set(s);
+            m_blue_stack.push_back(m_order.open(s, m_automat));
+        };
+
+        enter(automaton::INITIAL_STATE);
+        while (!m_blue_stack.empty() && !stopped())
+        {
+            auto& top = m_blue_stack.back();
+            if (!top.expanded())
+            {
+                const auto t = m_order.next(top);
+                // the own blue path closes the cycle through the accepting state
+                if (m_cyan.test(t) && (m_automat.is_final(top.state) || m_automat.is_final(t)))
+                    return false;
+                if (!m_cyan.test(t) && !m_colors.blue.test(t))
+                    /// \note invalidates @top
+                    enter(t);
+                continue;
+            }
+
+            const auto s = top.state;
+            m_order.close(top);
+            m_blue_stack.pop_back();
+
+            m_colors.blue.set(s);
+            if (m_automat.is_final(s) && !red_search(s))
+                return false;
+            m_cyan.reset(s);
+        }
+
+        return true;
+    }
+
+    /// \brief Peak bytes of the worker state
+    /// \note the stacks storage is never shrunk
+    /// \return estimated bytes
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return m_order.bytes() + m_cyan.bytes() + m_pink.bytes() + automates::memory::vector_bytes(m_reds) +
+               automates::memory::vector_bytes(m_blue_stack) + automates::memory::vector_bytes(m_red_stack);
+    }
+
+private:
+    /// \brief Check if the search must stop
+    /// \return true if the other worker has found the lasso
+    [[nodiscard]] bool stopped() const noexcept { return m_colors.cancelled.load(std::memory_order_relaxed); }
+
+    /// \brief Red (cycle) search from the accepting state. Then make its states red
+    /// \param q: the accepting state the search starts from
+    /// \return true if we have to continue investigation
+    bool red_search(const State q) noexcept
+    {
+        auto enter = [this](const State s)
+        {
+            m_pink.set(s);
+            m_reds.push_back(s);
+            m_red_stack.push_back(m_order.open(s, m_automat));
+        };
+
+        m_reds.clear();
+        enter(q);
+        while (!m_red_stack.empty() && !stopped())
+        {
+            auto& top = m_red_stack.back();
+            if (top.expanded())
+            {
+                m_order.close(top);
+                m_red_stack.pop_back();
+                continue;
+            }
+
+            const auto t = m_order.next(top);
+            if (m_cyan.test(t))
+                return false; // NONEMPTY NBA
+            if (!m_pink.test(t) && !m_colors.red.test(t))
+                /// \note invalidates @top
+                enter(t);
+        }
+
+        // other accepting states of the search are checked by their own red searches
+        for (const auto s : m_reds)
+            if (s != q && m_automat.is_final(s))
+                while (!m_colors.red.test(s) && !stopped())
+                    std::this_thread::yield();
+
+        for (const auto s : m_reds)
+        {
+            m_colors.red.set(s);
+            m_pink.reset(s);
+        }
+
+        return true;
+    }
+
+    /// \brief investigated automaton
+    const automaton &m_automat;
+    /// \brief shared colors
+    shared_colors &m_colors;
+    /// \brief own successors order
+    random_order<automaton> m_order;
+    /// \brief states on the own blue path
+    bit_array m_cyan;
+    /// \brief states of the current red search
+    bit_array m_pink;
+    /// \brief states of the current red search in the visiting order
+    std::vector<State> m_reds = {};
+    /// \brief explicit stack of the blue search
+    std::vector<typename random_order<automaton>::frame_type> m_blue_stack = {};
+    /// \brief explicit stack of the red search
+    std::vector<typename random_order<automaton>::frame_type> m_red_stack = {};
+};
+
+} // namespace anonymous
+
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak,
+              const unsigned threads) noexcept
+{
+    assert(!automat.is_generalized() && "NGA unsupported");
+
+    parallel::pool workers(threads);
+    shared_colors colors(automat.get_states_bound());
+    std::vector<std::size_t> scratch(workers.size(), 0);
+
+    workers.run([&](const unsigned id)
+    {
+        worker<State> search(automat, colors, id);
+        // the finished worker proves nothing alone: the red searches of the others may still be running
+        if (!search.run())
+            colors.cancelled.store(true);
+        scratch[id] = search.bytes();
+    });
+
+    if (scratch_peak)
+        *scratch_peak = std::accumulate(scratch.begin(), scratch.end(), std::size_t{0}) +
+                        colors.blue.bytes() + colors.red.bytes();
+
+    return !colors.cancelled.load();
+}
+
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak,
+              const unsigned threads) noexcept
+{
+    // compact (possibly sparse) states in the search order straight into the frozen table
+    const auto compact = utils::renumbering::renumber_frozen(automat, utils::renumbering::order::dfs).automaton;
+
+    const bool result = is_empty(compact, scratch_peak, threads);
+    /// \note the compacted copy is a part of the scratch
+    if (scratch_peak)
+        *scratch_peak += compact.memory_usage().total();
+
+    return result;
+}
+
+template bool is_empty(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*, unsigned) noexcept;
+
+template bool is_empty(const automates::basic_buchi<uint16_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty(const automates::basic_buchi<uint32_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty(const automates::basic_buchi<uint64_t>&, std::size_t*, unsigned) noexcept;
+
+} // namespace emptiness_check::dfs::cndfs
@@ -0,0 +1,240 @@
+#include "dfs/couvreur.hpp"
+#include "dfs/frame.hpp"
+
+#include <span>
+#include <vector>
+#include <algorithm>
+
+namespace emptiness_check::dfs::couvreur
+{
+
+/// \typedef to storing DFS visiting info: <state, DFS number>. 0 number marks the dead state (its SCC is complete)
+template<typename State>
+using um = std::unordered_map<State, std::size_t>;
+/// \typedef packed final indexes set (see automates::mask)
+using marks = std::span<const automates::mask::word>;
+
+/// \namespace Anonymous namespace. Helpers with DFS steps
+namespace
+{
+
+/// \class Stack of the SCC roots: <DFS number of the root, merged indexes set of the SCC>
+/// \details Numbers and packed indexes sets are stored in the two flat contiguous arrays. Each set occupies the
+///     same number of words, so uniting SCCs does not allocate once the arrays have grown
+class roots
+{
+public:
+    /// \brief Create empty stack
+    /// \param width: words in each packed indexes set
+    explicit roots(const std::size_t width) noexcept : m_width(width) {}
+
+    /// \brief Push new root of the trivial SCC
+    /// \param number: DFS number of the root
+    /// \param J: packed indexes set of the root state
+    void push(const std::size_t number, const marks J) noexcept
+    {
+        m_numbers.push_back(number);
+        m_marks.insert(m_marks.end(), J.begin(), J.begin() + static_cast<std::ptrdiff_t>(m_width));
+    }
+
+    /// \brief Remove the top root
+    void pop() noexcept
+    {
+        m_numbers.pop_back();
+        m_marks.resize(m_marks.size() - m_width);
+    }
+
+    /// \brief DFS number of the top root
+    /// \return number
+    [[nodiscard]] std::size_t top() const noexcept { return m_numbers.back(); }
+
+    /// \brief Indexes set of the top SCC
+    /// \return packed indexes set
+    [[nodiscard]] std::span<automates::mask::word> top_marks() noexcept
+    {
+        return { m_marks.data() + m_marks.size() - m_width, m_width };
+    }
+
+    /// \brief Bytes of the arrays
+    /// \note Storage is never shrunk: peak bytes
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return automates::memory::vector_bytes(m_numbers) + automates::memory::vector_bytes(m_marks);
+    }
+
+private:
+    /// \brief words in each indexes set
+    std::size_t m_width;
+    /// \brief DFS numbers of the roots
+    std::vector<std::size_t> m_numbers = {};
+    /// \brief indexes sets of the SCCs one after another
+    std::vector<automates::mask::word> m_marks = {};
+};
+
+/// \struct Search state
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+struct context
+{
+    /// \brief Create empty search state
+    /// \param automat: investigated automaton
+    explicit context(const Automaton &automat) noexcept
+        : R(automat.get_mask_words_num()), I(automat.get_mask_words_num(), 0)
+    {}
+
+    /// \brief DFS numbers of the visited states. Dead states have 0
+    um<typename Automaton::atm_size> H = {};
+    /// \brief roots of the not yet complete SCCs with their merged indexes sets
+    roots R;
+    /// \brief live states (visited, not dead) in the discovery order. SCC of the root is on the top above it
+    std::vector<typename Automaton::atm_size> L = {};
+    /// \brief last DFS number
+    std::size_t n = 0;
+    /// \brief merged indexes set of the united SCCs. Reused by all merges
+    std::vector<automates::mask::word> I;
+};
+
+/// \brief Number the state and make it the root of the new trivial SCC
+/// \param Automaton: investigated automaton representation
+/// \param q: discovered state
+/// \param[in,out] ctx: search state
+/// \param automat: investigated automat
+template<typename Automaton>
+void discover(const typename Automaton::atm_size q, context<Automaton> &ctx, const Automaton &automat) noexcept
+{
+    ctx.H[q] = ++ctx.n;
+    ctx.R.push(ctx.n, automat.indexes_final_sets(q));
+    ctx.L.push_back(q);
+}
+
+/// \brief Edge to the live state closes a cycle: unite SCCs above its SCC. Will notify NONEMPTY
+/// \param Automaton: investigated automaton representation
+/// \param number: DFS number of the reached live state
+/// \param[in,out] ctx: search state
+/// \param automat: investigated automat
+/// \return true if we have to continue investigation
+template<typename Automaton>
+bool unite(const std::size_t number, context<Automaton> &ctx, const Automaton &automat) noexcept
+{
+    auto& [H, R, L, n, I] = ctx;
+
+    std::fill(I.begin(), I.end(), 0);
+    while (R.top() > number)
+    {
+        automates::mask::merge(I, R.top_marks());
+        R.pop();
+    }
+    automates::mask::merge(R.top_marks(), I);
+
+    // NONEMPTY NBA/NGA: the united SCC covers all final sets
+    return !automates::mask::is_full(R.top_marks(), automat.get_final_num_sets());
+}
+
+/// \brief Fully expanded state. If it is the root, its SCC is complete: kill all states of the SCC
+/// \param Automaton: investigated automaton representation
+/// \param q: fully expanded state
+/// \param[in,out] ctx: search state
+template<typename Automaton>
+void close(const typename Automaton::atm_size q, context<Automaton> &ctx) noexcept
+{
+    auto& [H, R, L, n, I] = ctx;
+
+    if (R.top() != H[q])
+        return;
+
+    R.pop();
+    typename Automaton::atm_size s;
+    do {
+        s = L.back();
+        L.pop_back();
+        H[s] = 0;
+    } while (s != q);
+}
+
+/// \brief Iterative DFS search. Will notify NONEMPTY
+/// \note Frames are kept on the explicit heap-allocated stack: depth is limited by memory only
+/// \param Automaton: investigated automaton representation
+/// \param q: the state the search starts from
+/// \param[in,out] ctx: search state
+/// \param[in,out] frames: explicit DFS stack
+/// \param automat: investigated automat
+/// \return true if we have to continue investigation
+template<typename Automaton>
+bool dfs(const typename Automaton::atm_size q, context<Automaton> &ctx, std::vector<frame<Automaton>> &frames,
+         const Automaton &automat) noexcept
+{
+    discover(q, ctx, automat);
+    frames.emplace_back(q, automat);
+
+    while (!frames.empty())
+    {
+        auto& top = frames.back();
+        if (!top.expanded())
+        {
+            const auto r = *top.next++;
+            if (const auto &it = ctx.H.find(r); it == ctx.H.end())
+            {
+                discover(r, ctx, automat);
+                /// \note invalidates @top
+                frames.emplace_back(r, automat);
+            }
+            else if (it->second && !unite(it->second, ctx, automat))
+                return false;
+            continue;
+        }
+
+        // all successors are visited
+        const auto s = top.state;
+        frames.pop_back();
+        close(s, ctx);
+    }
+
+    return true;
+}
+
+/// \brief Couvreur entry point for any automaton representation
+/// \param Automaton: investigated automaton representation
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search state and frames (if requested)
+/// \return false if it finds at least one (first) lasso
+template<typename Automaton>
+bool run(const Automaton &automat, std::size_t *scratch_peak) noexcept
+{
+    context<Automaton> ctx(automat);
+    std::vector<frame<Automaton>> frames;
+
+    const bool result = dfs(Automaton::INITIAL_STATE, ctx, frames, automat);
+
+    /// \note H only grows, the stacks storage is never shrunk
+    if (scratch_peak)
+        *scratch_peak = automates::memory::hashed_bytes(ctx.H) + ctx.R.bytes() +
+                        automates::memory::vector_bytes(ctx.L) + automates::memory::vector_bytes(ctx.I) +
+                        automates::memory::vector_bytes(frames);
+
+    return result;
+}
+
+} // namespace anonymous
+
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run(automat, scratch_peak);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run(automat, scratch_peak);
+}
+
+template bool is_empty(const automates::basic_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*) noexcept;
+
+} // namespace emptiness_check::dfs::couvreur
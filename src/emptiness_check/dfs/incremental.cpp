@@ -0,0 +1,349 @@
+#include "dfs/incremental.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace emptiness_check::dfs::incremental
+{
+
+template<typename State>
+checker<State>::checker(const automates::basic_buchi<State> &automat) noexcept
+    : m_finals(automat.get_final_states()), m_sets_num(automat.get_final_num_sets()),
+      m_width(automat.get_mask_words_num())
+{
+    intern(automates::basic_buchi<State>::INITIAL_STATE);
+    for (const auto& [from, set] : automat.m_trans_table)
+        for (const auto to : set)
+        {
+            const auto u = intern(from), v = intern(to);
+            m_successors[u].push_back(v);
+            m_predecessors[v].push_back(u);
+        }
+
+    decompose();
+    reach(0);
+}
+
+template<typename State>
+checker<State>::checker(const automates::basic_frozen_buchi<State> &automat) noexcept
+    : m_finals(automat.get_final_states()), m_sets_num(automat.get_final_num_sets()),
+      m_width(automat.get_mask_words_num())
+{
+    intern(automates::basic_frozen_buchi<State>::INITIAL_STATE);
+    for (std::size_t from = 0; from < automat.get_states_bound(); ++from)
+        for (const auto to : automat.successors(static_cast<State>(from)))
+        {
+            const auto u = intern(static_cast<State>(from)), v = intern(to);
+            m_successors[u].push_back(v);
+            m_predecessors[v].push_back(u);
+        }
+
+    decompose();
+    reach(0);
+}
+
+template<typename State>
+std::size_t checker<State>::intern(const State q) noexcept
+{
+    const auto &[it, inserted] = m_numbers.try_emplace(q, m_successors.size());
+    if (!inserted)
+        return it->second;
+
+    const auto v = it->second;
+    m_successors.emplace_back();
+    m_predecessors.emplace_back();
+    m_reached.push_back(0);
+    m_parent.push_back(v);
+    m_order.push_back(m_next_order++);
+    m_members.push_back({ v });
+    m_cyclic.push_back(0);
+    m_forward.push_back(0);
+    m_backward.push_back(0);
+    m_marks.resize(m_marks.size() + m_width, 0);
+    for (std::size_t i = 0; i < m_sets_num; ++i)
+        if (m_finals[i].contains(q))
+            marks(v)[i / automates::mask::WORD_BITS] |= automates::mask::word{1} << (i % automates::mask::WORD_BITS);
+    ++m_components_num;
+
+    return v;
+}
+
+template<typename State>
+void checker<State>::decompose() noexcept
+{
+    const auto n = m_successors.size();
+    constexpr auto UNVISITED = std::numeric_limits<std::size_t>::max();
+    // Tarjan's numbers and lowlinks by the dense states
+    std::vector<std::size_t> number(n, UNVISITED), low(n);
+    std::vector<char> on_stack(n, 0);
+    std::vector<std::size_t> S;
+    // explicit DFS stack: <state, next successor index>
+    std::vector<std::pair<std::size_t, std::size_t>> frames;
+    std::size_t counter = 0, completed = 0;
+
+    m_components_num = 0;
+    for (std::size_t root = 0; root < n; ++root)
+    {
+        if (number[root] != UNVISITED)
+            continue;
+
+        auto discover = [&](const std::size_t v)
+        {
+            number[v] = low[v] = counter++;
+            on_stack[v] = 1;
+            S.push_back(v);
+            frames.emplace_back(v, 0);
+        };
+
+        discover(root);
+        while (!frames.empty())
+        {
+            auto& [v, next] = frames.back();
+            if (next < m_successors[v].size())
+            {
+                const auto w = m_successors[v][next++];
+                if (number[w] == UNVISITED)
+                    /// \note invalidates @v and @next
+                    discover(w);
+                else if (on_stack[w])
+                    low[v] = std::min(low[v], number[w]);
+                continue;
+            }
+
+            const auto q = v;
+            frames.pop_back();
+            if (!frames.empty())
+                low[frames.back().first] = std::min(low[frames.back().first], low[q]);
+            if (low[q] != number[q])
+                continue;
+
+            // the root completes its SCC. Sinks complete first: they get the last positions
+            auto& members = m_members[q];
+            members.clear();
+            std::size_t s;
+            do {
+                s = S.back();
+                S.pop_back();
+                on_stack[s] = 0;
+                m_parent[s] = q;
+                members.push_back(s);
+                if (s != q)
+                {
+                    automates::mask::merge(marks(q), marks(s));
+                    m_members[s] = {};
+                }
+            } while (s != q);
+
+            m_order[q] = n - completed++;
+            m_cyclic[q] = members.size() > 1 ||
+                          std::find(m_successors[q].begin(), m_successors[q].end(), q) != m_successors[q].end();
+            ++m_components_num;
+        }
+    }
+
+    m_next_order = n + 1;
+}
+
+template<typename State>
+std::size_t checker<State>::find(std::size_t v) noexcept
+{
+    // path halving
+    while (m_parent[v] != v)
+        v = m_parent[v] = m_parent[m_parent[v]];
+
+    return v;
+}
+
+template<typename State>
+std::size_t checker<State>::unite(const std::vector<std::size_t> &components) noexcept
+{
+    // the biggest members list absorbs the others
+    const auto rep = *std::max_element(components.begin(), components.end(),
+            [this](const std::size_t a, const std::size_t b) { return m_members[a].size() < m_members[b].size(); });
+
+    for (const auto c : components)
+    {
+        if (c == rep)
+            continue;
+
+        m_parent[c] = rep;
+        m_members[rep].insert(m_members[rep].end(), m_members[c].begin(), m_members[c].end());
+        m_members[c] = {};
+        automates::mask::merge(marks(rep), marks(c));
+        --m_components_num;
+    }
+    m_cyclic[rep] = 1;
+
+    return rep;
+}
+
+template<typename State>
+void checker<State>::check(const std::size_t c) noexcept
+{
+    /// \note the reachable states are closed under the transitions: one reachable member means the whole SCC
+    if (m_cyclic[c] && m_reached[c] && automates::mask::is_full(marks(c), m_sets_num))
+        m_nonempty = true;
+}
+
+template<typename State>
+void checker<State>::reach(const std::size_t v) noexcept
+{
+    if (m_reached[v])
+        return;
+
+    std::vector<std::size_t> stack = { v };
+    m_reached[v] = 1;
+    while (!stack.empty())
+    {
+        const auto w = stack.back();
+        stack.pop_back();
+        ++m_touched;
+        check(find(w));
+
+        for (const auto s : m_successors[w])
+            if (!m_reached[s])
+            {
+                m_reached[s] = 1;
+                stack.push_back(s);
+            }
+    }
+}
+
+template<typename State>
+void checker<State>::update_order(const std::size_t u, const std::size_t v) noexcept
+{
+    const auto cu = find(u), cv = find(v);
+    if (cu == cv)
+    {
+        m_cyclic[cu] = 1;
+        return;
+    }
+
+    // the order is kept: nothing is affected
+    const auto lb = m_order[cv], ub = m_order[cu];
+    if (lb > ub)
+        return;
+
+    // affected region: SCCs reachable from @cv before @cu in the order and SCCs reaching @cu after @cv
+    ++m_stamp;
+    bool cycle = false;
+    std::vector<std::size_t> F = { cv }, B = { cu };
+    m_forward[cv] = m_backward[cu] = m_stamp;
+    for (std::size_t head = 0; head < F.size(); ++head)
+        for (const auto m : m_members[F[head]])
+            for (const auto t : m_successors[m])
+                if (const auto y = find(t); y == cu)
+                    cycle = true;
+                else if (m_order[y] < ub && m_forward[y] != m_stamp)
+                {
+                    m_forward[y] = m_stamp;
+                    F.push_back(y);
+                }
+    for (std::size_t head = 0; head < B.size(); ++head)
+        for (const auto m : m_members[B[head]])
+            for (const auto p : m_predecessors[m])
+                if (const auto y = find(p); m_order[y] > lb && m_backward[y] != m_stamp)
+                {
+                    m_backward[y] = m_stamp;
+                    B.push_back(y);
+                }
+    m_touched += F.size() + B.size();
+
+    // SCCs on the paths @cv ~> @cu close the cycle through the new transition
+    auto closed = [&](const std::size_t x)
+    {
+        return cycle && (x == cu || x == cv || (m_forward[x] == m_stamp && m_backward[x] == m_stamp));
+    };
+
+    // the region positions are reused: B (without the cycle) takes the lowest ones and F (without the cycle) the
+    // highest ones, so no SCC moves across the SCCs outside the region. The merged cycle takes one in between
+    std::vector<std::size_t> positions, cyclic;
+    for (const auto x : F)
+        positions.push_back(m_order[x]);
+    for (const auto x : B)
+        if (m_forward[x] != m_stamp)
+            positions.push_back(m_order[x]);
+    std::sort(positions.begin(), positions.end());
+
+    auto by_order = [this](const std::size_t a, const std::size_t b) { return m_order[a] < m_order[b]; };
+    std::sort(F.begin(), F.end(), by_order);
+    std::sort(B.begin(), B.end(), by_order);
+
+    auto low = positions.begin();
+    for (const auto x : B)
+        if (!closed(x))
+            m_order[x] = *low++;
+        else
+            cyclic.push_back(x);
+
+    auto high = positions.rbegin();
+    for (auto it = F.rbegin(); it != F.rend(); ++it)
+        if (!closed(*it))
+            m_order[*it] = *high++;
+
+    if (cycle)
+    {
+        for (const auto x : F)
+            if (closed(x) && m_backward[x] != m_stamp)
+                cyclic.push_back(x);
+        m_order[unite(cyclic)] = *low;
+    }
+}
+
+template<typename State>
+void checker<State>::insert(const State from, const State to) noexcept
+{
+    const auto u = intern(from), v = intern(to);
+    if (std::find(m_successors[u].begin(), m_successors[u].end(), v) != m_successors[u].end())
+        return;
+
+    m_successors[u].push_back(v);
+    m_predecessors[v].push_back(u);
+
+    update_order(u, v);
+    if (m_reached[u])
+        reach(v);
+    check(find(u));
+}
+
+template<typename State>
+bool checker<State>::add_edge(const State from, const State to) noexcept
+{
+    m_touched = 0;
+    insert(from, to);
+
+    return is_empty();
+}
+
+template<typename State>
+bool checker<State>::add_edges(const std::span<const edge> batch) noexcept
+{
+    m_touched = 0;
+    for (const auto& [from, to] : batch)
+        insert(from, to);
+
+    return is_empty();
+}
+
+template<typename State>
+std::size_t checker<State>::bytes() const noexcept
+{
+    std::size_t bytes = automates::memory::hashed_bytes(m_numbers) +
+                        automates::memory::vector_bytes(m_successors) +
+                        automates::memory::vector_bytes(m_predecessors) +
+                        automates::memory::vector_bytes(m_reached) + automates::memory::vector_bytes(m_parent) +
+                        automates::memory::vector_bytes(m_order) + automates::memory::vector_bytes(m_members) +
+                        automates::memory::vector_bytes(m_cyclic) + automates::memory::vector_bytes(m_marks) +
+                        automates::memory::vector_bytes(m_forward) + automates::memory::vector_bytes(m_backward);
+    for (std::size_t v = 0; v < m_successors.size(); ++v)
+        bytes += automates::memory::vector_bytes(m_successors[v]) +
+                 automates::memory::vector_bytes(m_predecessors[v]) + automates::memory::vector_bytes(m_members[v]);
+
+    return bytes;
+}
+
+template class checker<uint16_t>;
+template class checker<uint32_t>;
+template class checker<uint64_t>;
+
+} // namespace emptiness_check::dfs::incremental
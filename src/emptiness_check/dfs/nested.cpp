@@ -1,87 +1,517 @@
 #include "dfs/nested.hpp"
+#include "dfs/frame.hpp"
 
+#include "parallel/pool.hpp"
+#include "utils/renumbering.hpp"
+
+#include <atomic>
 #include <bitset>
+#include <algorithm>
+#include <vector>
+#include <numeric>
 #include <cassert>
 
 namespace emptiness_check::dfs::nested
 {
 
 /// \typedef to storing DFS visiting info: <state, <first entrance bit, final state mark entrance>>
-using um = std::unordered_map<automates::buchi::atm_size, std::bitset<2>>;
+template<typename State>
+using um = std::unordered_map<State, std::bitset<2>>;
 /// \typedef to storing states of the path
-using us = std::unordered_set<automates::buchi::atm_size>;
+template<typename State>
+using us = std::unordered_set<State>;
 
 /// \namespace Anonymous namespace. Helpers with DFS steps
 namespace
 {
 
+/// \enum Search phase that visits the state
+enum phase : unsigned
+{
+    /// \brief first (blackening) search
+    FIRST = 0,
+    /// \brief second (cycle) search
+    SECOND = 1
+};
+
+/// \class Visiting info in the hashed containers: any (sparse) state numbers
+/// \param State: state type of the automaton
+template<typename State>
+class hashed_marks
+{
+public:
+    /// \brief Mark the state as visited by the search phase
+    /// \param q: automaton state
+    /// \param ph: search phase
+    /// \return true if the state was already visited by this phase
+    bool visit(const State q, const phase ph) noexcept
+    {
+        auto& bits = m_visited[q];
+        const bool visited = bits.test(ph);
+        bits.set(ph);
+        return visited;
+    }
+
+    /// \brief Check if the state is on the path of the first search
+    /// \param q: automaton state
+    /// \return true if the state is on the path
+    [[nodiscard]] bool on_path(const State q) const noexcept { return m_path.find(q) != m_path.end(); }
+
+    /// \brief Put the state on the path of the first search
+    /// \param q: automaton state
+    void push_path(const State q) noexcept
+    {
+        m_path.insert(q);
+        m_path_peak = std::max(m_path_peak, m_path.size());
+    }
+
+    /// \brief Remove the state from the path of the first search
+    /// \param q: automaton state
+    void pop_path(const State q) noexcept { m_path.erase(q); }
+
+    /// \brief Peak bytes of the visiting info
+    /// \note visited only grows, path buckets are never shrunk
+    /// \return estimated bytes
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return automates::memory::hashed_bytes(m_visited) + automates::memory::hashed_bytes(m_path, m_path_peak);
+    }
+
+private:
+    /// \brief DFS state visiting info
+    um<State> m_visited;
+    /// \brief current story of the state of the path
+    us<State> m_path;
+    /// \brief maximal size of @m_path
+    std::size_t m_path_peak = 0;
+};
+
+/// \class Visiting info packed into the bit array: 3 bits per state (two phases and the path)
+/// \note Requires dense state numbers: the array has a field for every state below the bound
+class packed_marks
+{
+public:
+    /// \brief Create unvisited fields for the states [0, @states_num)
+    /// \param states_num: exclusive upper bound of the state numbers
+    explicit packed_marks(const std::size_t states_num) noexcept
+        : m_words((states_num + FIELDS_PER_WORD - 1) / FIELDS_PER_WORD, 0), m_states_num(states_num)
+    {}
+
+    /// \brief Mark the state as visited by the search phase
+    /// \param q: automaton state
+    /// \param ph: search phase
+    /// \return true if the state was already visited by this phase
+    bool visit(const std::size_t q, const phase ph) noexcept
+    {
+        auto& word = field_word(q);
+        const auto bit = field_bit(q, ph);
+        const bool visited = word & bit;
+        word |= bit;
+        return visited;
+    }
+
+    /// \brief Check if the state is on the path of the first search
+    /// \param q: automaton state
+    /// \return true if the state is on the path
+    [[nodiscard]] bool on_path(const std::size_t q) const noexcept
+    {
+        return m_words[q / FIELDS_PER_WORD] & field_bit(q, PATH_BIT);
+    }
+
+    /// \brief Put the state on the path of the first search
+    /// \param q: automaton state
+    void push_path(const std::size_t q) noexcept { field_word(q) |= field_bit(q, PATH_BIT); }
+
+    /// \brief Remove the state from the path of the first search
+    /// \param q: automaton state
+    void pop_path(const std::size_t q) noexcept { field_word(q) &= ~field_bit(q, PATH_BIT); }
+
+    /// \brief Bytes of the bit array
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept { return automates::memory::vector_bytes(m_words); }
+
+private:
+    /// \brief Bits per state field: two phases and the path
+    static constexpr std::size_t FIELD_BITS = 3;
+    /// \brief Fields do not cross the words: 21 fields in 63 bits
+    static constexpr std::size_t FIELDS_PER_WORD = automates::mask::WORD_BITS / FIELD_BITS;
+    /// \brief Index of the path bit in the field
+    static constexpr unsigned PATH_BIT = 2;
+
+    /// \brief Word that stores the field of the state
+    /// \param q: automaton state
+    /// \return word reference
+    automates::mask::word& field_word(const std::size_t q) noexcept
+    {
+        assert(q < m_states_num && "State out of the packed array");
+        return m_words[q / FIELDS_PER_WORD];
+    }
+
+    /// \brief Mask of the one bit of the state field
+    /// \param q: automaton state
+    /// \param bit: bit index in the field
+    /// \return word with the one set bit
+    static automates::mask::word field_bit(const std::size_t q, const unsigned bit) noexcept
+    {
+        return automates::mask::word{1} << ((q % FIELDS_PER_WORD) * FIELD_BITS + bit);
+    }
+
+    /// \brief packed fields
+    std::vector<automates::mask::word> m_words;
+    /// \brief number of the fields
+    std::size_t m_states_num;
+};
+
+/// \struct Search state shared by both DFS phases
+/// \param Automaton: investigated automaton representation
+/// \param Marks: visiting info storage (hashed or packed)
+/// \param Order: successors visiting order
+template<typename Automaton, typename Marks, typename Order = search_order<Automaton>>
+struct context
+{
+    /// \brief DFS state visiting info with the current path
+    Marks marks;
+    /// \brief successors visiting order
+    Order order = {};
+    /// \brief explicit stack of the first (blackening) search
+    std::vector<typename Order::frame_type> outer = {};
+    /// \brief explicit stack of the second (cycle) search. Reused by all nested calls
+    std::vector<typename Order::frame_type> inner = {};
+    /// \brief set by the other (swarm) worker that already has the answer
+    const std::atomic<bool> *cancelled = nullptr;
+    /// \brief state of the path reached by the second search (valid after NONEMPTY)
+    typename Automaton::atm_size closing = {};
+
+    /// \brief Check if the search must stop
+    /// \return true if the other worker has the answer
+    [[nodiscard]] bool stopped() const noexcept
+    {
+        return cancelled && cancelled->load(std::memory_order_relaxed);
+    }
+
+    /// \brief Peak bytes of the search state
+    /// \note the stacks storage is never shrunk
+    /// \return estimated bytes
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return marks.bytes() + order.bytes() +
+               automates::memory::vector_bytes(outer) + automates::memory::vector_bytes(inner);
+    }
+};
+
 /// \brief Check if q is reachable from itself. Will notify NONEMPTY
-/// \param q: the state in which we are now
-/// \param[in,out] S: DFS state visiting info
-/// \param[in,out] P: current story of the state of the path
+/// \param Automaton: investigated automaton representation
+/// \param Marks: visiting info storage
+/// \param Order: successors visiting order
+/// \param q: the accepting state the search starts from
+/// \param[in,out] ctx: search state
 /// \param automat: investigated automat
 /// \return true if we have to continue investigation
-bool dfs2(const automates::buchi::atm_size q, um& S, const us& P, const automates::buchi &automat) noexcept
+template<typename Automaton, typename Marks, typename Order>
+bool dfs2(const typename Automaton::atm_size q, context<Automaton, Marks, Order> &ctx,
+          const Automaton &automat) noexcept
 {
-    S[q].set(1);
+    auto& [marks, order, outer, inner, cancelled, closing] = ctx;
 
-    if (auto iter = automat.m_trans_table.find(q); iter != automat.m_trans_table.end())
+    marks.visit(q, SECOND);
+    inner.push_back(order.open(q, automat));
+
+    while (!inner.empty() && !ctx.stopped())
     {
-        for (const auto &r : iter->second)
+        auto& top = inner.back();
+        if (top.expanded())
+        {
+            order.close(top);
+            inner.pop_back();
+            continue;
+        }
+
+        const auto r = order.next(top);
+        if (marks.on_path(r))
         {
-            if (P.find(r) != P.end())
-                return false; // NONEMPTY NBA
-            if (const auto &it_bits = S.find(r);
-                    it_bits == S.end() || !it_bits->second.test(1))
-            {
-                if (!dfs2(r, S, P, automat))
-                    return false;
-            }
+            closing = r;
+            return false; // NONEMPTY NBA
         }
+        if (!marks.visit(r, SECOND))
+            /// \note invalidates @top
+            inner.push_back(order.open(r, automat));
     }
 
     return true;
 }
 
-/// \brief Blackens an accepting state q. Handle @dfs2 notification
-/// \param q: the state in which we are now
-/// \param[in,out] S: DFS state visiting info
-/// \param[in,out] P: current story of the state of the path
+/// \brief Blackens accepting states in post-order starting from q. Handle @dfs2 notification
+/// \param Automaton: investigated automaton representation
+/// \param Marks: visiting info storage
+/// \param Order: successors visiting order
+/// \param q: the state the search starts from
+/// \param[in,out] ctx: search state
 /// \param automat: investigated automat
 /// \return true if we have to continue investigation
-bool dfs1(const automates::buchi::atm_size q, um& S, us& P, const automates::buchi &automat) noexcept
+template<typename Automaton, typename Marks, typename Order>
+bool dfs1(const typename Automaton::atm_size q, context<Automaton, Marks, Order> &ctx,
+          const Automaton &automat) noexcept
 {
-    S[q].set(0);
-    P.insert(q);
+    auto& [marks, order, outer, inner, cancelled, closing] = ctx;
 
-    if (auto iter = automat.m_trans_table.find(q); iter != automat.m_trans_table.end())
+    // grey the state: put on the path and start its expansion
+    auto enter = [&marks = marks, &order = order, &outer = outer, &automat](const typename Automaton::atm_size s)
     {
-        for (const auto &r : iter->second)
-            if (const auto &it_bits = S.find(r);
-                    it_bits == S.end() || !it_bits->second.test(0))
-            {
-                if (!dfs1(r, S, P, automat))
-                    return false;
-            }
-    }
-    /// \note: better to add 0 due to NBA
-    if (automat.is_final(q))
-        if (!dfs2(q, S, P, automat))
+        marks.push_path(s);
+        outer.push_back(order.open(s, automat));
+    };
+
+    marks.visit(q, FIRST);
+    enter(q);
+    while (!outer.empty() && !ctx.stopped())
+    {
+        auto& top = outer.back();
+        if (!top.expanded())
+        {
+            const auto r = order.next(top);
+            if (!marks.visit(r, FIRST))
+                /// \note invalidates @top
+                enter(r);
+            continue;
+        }
+
+        // all successors are visited: blacken the state
+        const auto s = top.state;
+        order.close(top);
+        outer.pop_back();
+        /// \note: better to add 0 due to NBA
+        if (automat.is_final(s) && !dfs2(s, ctx, automat))
             return false;
 
-    P.erase(q);
+        marks.pop_path(s);
+    }
 
     return true;
 }
 
-} // namespace anonymous
+/// \brief Nested-DFS entry point for any automaton representation and visiting info storage
+/// \param Automaton: investigated automaton representation
+/// \param Marks: visiting info storage
+/// \param automat: investigated automaton
+/// \param marks: empty visiting info storage
+/// \param[out] scratch_peak: peak bytes of the search state (if requested)
+/// \return false if it finds at least one (first) lasso
+template<typename Automaton, typename Marks>
+bool run(const Automaton &automat, Marks marks, std::size_t *scratch_peak) noexcept
+{
+    assert(!automat.is_generalized() && "NGA unsupported");
+
+    context<Automaton, Marks> ctx{ .marks = std::move(marks) };
+    const bool result = dfs1(Automaton::INITIAL_STATE, ctx, automat);
+
+    if (scratch_peak)
+        *scratch_peak = ctx.bytes();
+
+    return result;
+}
+
+/// \brief Rebuild the lasso from the stacks of the interrupted (NONEMPTY) search
+/// \details The first search stack with the accepting state (the root of the second search) is the path. The reached
+///     state splits it into the stem and the beginning of the cycle. The second search stack closes the cycle
+/// \param Automaton: investigated automaton representation
+/// \param Marks: visiting info storage
+/// \param ctx: search state at the moment of NONEMPTY notification
+/// \return found lasso
+template<typename Automaton, typename Marks>
+lasso<typename Automaton::atm_size> extract_lasso(const context<Automaton, Marks> &ctx) noexcept
+{
+    std::vector<typename Automaton::atm_size> path;
+    path.reserve(ctx.outer.size() + 1);
+    for (const auto& f : ctx.outer)
+        path.push_back(f.state);
+    path.push_back(ctx.inner.front().state);
+
+    const auto entry = std::find(path.begin(), path.end(), ctx.closing);
+    assert(entry != path.end() && "Second search reached a state out of the path");
+
+    lasso<typename Automaton::atm_size> res{ .stem = { path.begin(), entry }, .cycle = { entry, path.end() } };
+    for (auto it = std::next(ctx.inner.begin()); it != ctx.inner.end(); ++it)
+        res.cycle.push_back(it->state);
+
+    return res;
+}
+
+/// \brief Nested-DFS entry point that returns the lasso found
+/// \param Automaton: investigated automaton representation
+/// \param automat: investigated automaton
+/// \return the first lasso or nullopt for the empty automaton
+template<typename Automaton>
+std::optional<lasso<typename Automaton::atm_size>> run_lasso(const Automaton &automat) noexcept
+{
+    assert(!automat.is_generalized() && "NGA unsupported");
 
-bool is_empty(const automates::buchi &automat) noexcept
+    context<Automaton, hashed_marks<typename Automaton::atm_size>> ctx{};
+    if (dfs1(Automaton::INITIAL_STATE, ctx, automat))
+        return std::nullopt;
+
+    return extract_lasso(ctx);
+}
+
+/// \brief Swarm of the independent Nested-DFS workers with the different random successors orders
+/// \details The first finished worker (lasso found or the whole state space explored) cancels the others
+/// \param Automaton: investigated automaton representation
+/// \param MarksFactory: callback that creates the empty visiting info storage of a worker
+/// \param automat: investigated automaton
+/// \param make_marks: visiting info factory
+/// \param[out] scratch_peak: sum of the peak bytes of all workers (if requested)
+/// \param threads: number of the workers. 0 means all hardware threads
+/// \return false if it finds at least one (first) lasso
+template<typename Automaton, typename MarksFactory>
+bool run_swarm(const Automaton &automat, const MarksFactory &make_marks, std::size_t *scratch_peak,
+               const unsigned threads) noexcept
 {
     assert(!automat.is_generalized() && "NGA unsupported");
 
-    um S; us P;
-    return dfs1(automates::buchi::INITIAL_STATE, S, P, automat);
+    parallel::pool workers(threads);
+    std::atomic<bool> cancelled = false;
+    bool result = true;
+    std::vector<std::size_t> scratch(workers.size(), 0);
+
+    workers.run([&](const unsigned id)
+    {
+        using order = random_order<Automaton>;
+        context<Automaton, decltype(make_marks()), order> ctx{ .marks = make_marks(), .order = order(id),
+                                                               .cancelled = &cancelled };
+        const bool empty = dfs1(Automaton::INITIAL_STATE, ctx, automat);
+        // the cancelled workers are interrupted: their answer is unknown
+        if (!cancelled.exchange(true))
+            result = empty;
+        scratch[id] = ctx.bytes();
+    });
+
+    if (scratch_peak)
+        *scratch_peak = std::accumulate(scratch.begin(), scratch.end(), std::size_t{0});
+
+    return result;
+}
+
+/// \brief Nested-DFS with the packed visiting info on the frozen automaton
+/// \param State: state type of the automaton
+/// \param automat: investigated automaton. All its states are below the states bound
+/// \param[out] scratch_peak: peak bytes of the search state (if requested)
+/// \return false if it finds at least one (first) lasso
+template<typename State>
+bool run_packed(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run(automat, packed_marks(automat.get_states_bound()), scratch_peak);
+}
+
+} // namespace anonymous
+
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run(automat, hashed_marks<State>{}, scratch_peak);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run(automat, hashed_marks<State>{}, scratch_peak);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_implicit_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run(automat, hashed_marks<State>{}, scratch_peak);
+}
+
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_buchi<State> &automat) noexcept
+{
+    return run_lasso(automat);
+}
+
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_frozen_buchi<State> &automat) noexcept
+{
+    return run_lasso(automat);
+}
+
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_implicit_buchi<State> &automat) noexcept
+{
+    return run_lasso(automat);
+}
+
+template<typename State>
+bool is_empty_packed(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    // compact (possibly sparse) states in the search order straight into the frozen table
+    const auto compact = utils::renumbering::renumber_frozen(automat, utils::renumbering::order::dfs).automaton;
+
+    const bool result = run_packed(compact, scratch_peak);
+    /// \note the compacted copy is a part of the scratch
+    if (scratch_peak)
+        *scratch_peak += compact.memory_usage().total();
+
+    return result;
 }
 
+template<typename State>
+bool is_empty_packed(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run_packed(automat, scratch_peak);
+}
+
+template<typename State>
+bool is_empty_swarm(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak,
+                    const unsigned threads) noexcept
+{
+    return run_swarm(automat, [] { return hashed_marks<State>{}; }, scratch_peak, threads);
+}
+
+template<typename State>
+bool is_empty_swarm(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak,
+                    const unsigned threads) noexcept
+{
+    return run_swarm(automat, [&automat] { return packed_marks(automat.get_states_bound()); },
+                     scratch_peak, threads);
+}
+
+template bool is_empty(const automates::basic_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty(const automates::basic_implicit_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_implicit_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_implicit_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template std::optional<lasso<uint16_t>> find_lasso(const automates::basic_buchi<uint16_t>&) noexcept;
+template std::optional<lasso<uint32_t>> find_lasso(const automates::basic_buchi<uint32_t>&) noexcept;
+template std::optional<lasso<uint64_t>> find_lasso(const automates::basic_buchi<uint64_t>&) noexcept;
+
+template std::optional<lasso<uint16_t>> find_lasso(const automates::basic_frozen_buchi<uint16_t>&) noexcept;
+template std::optional<lasso<uint32_t>> find_lasso(const automates::basic_frozen_buchi<uint32_t>&) noexcept;
+template std::optional<lasso<uint64_t>> find_lasso(const automates::basic_frozen_buchi<uint64_t>&) noexcept;
+
+template std::optional<lasso<uint16_t>> find_lasso(const automates::basic_implicit_buchi<uint16_t>&) noexcept;
+template std::optional<lasso<uint32_t>> find_lasso(const automates::basic_implicit_buchi<uint32_t>&) noexcept;
+template std::optional<lasso<uint64_t>> find_lasso(const automates::basic_implicit_buchi<uint64_t>&) noexcept;
+
+template bool is_empty_packed(const automates::basic_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty_packed(const automates::basic_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty_packed(const automates::basic_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty_packed(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty_packed(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty_packed(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty_swarm(const automates::basic_buchi<uint16_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty_swarm(const automates::basic_buchi<uint32_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty_swarm(const automates::basic_buchi<uint64_t>&, std::size_t*, unsigned) noexcept;
+
+template bool is_empty_swarm(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty_swarm(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty_swarm(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*, unsigned) noexcept;
+
 } // namespace emptiness_check::dfs::nested
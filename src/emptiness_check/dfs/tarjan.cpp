@@ -0,0 +1,196 @@
+#include "dfs/tarjan.hpp"
+#include "dfs/frame.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace emptiness_check::dfs::tarjan
+{
+
+template<typename State>
+scc_table<State>::scc_table(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+    : m_width(automat.get_mask_words_num()), m_sets_num(automat.get_final_num_sets())
+{
+    const auto peak = decompose(automat);
+    if (scratch_peak)
+        *scratch_peak = peak;
+}
+
+template<typename State>
+scc_table<State>::scc_table(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+    : m_width(automat.get_mask_words_num()), m_sets_num(automat.get_final_num_sets())
+{
+    const auto peak = decompose(automat);
+    if (scratch_peak)
+        *scratch_peak = peak;
+}
+
+template<typename State>
+template<typename Automaton>
+std::size_t scc_table<State>::decompose(const Automaton &automat) noexcept
+{
+    // lowlinks by the DFS numbers while the states are on the Tarjan's stack. Completion puts the component id there
+    auto& low = m_components;
+    // on the Tarjan's stack flag by the DFS numbers
+    std::vector<char> on_stack;
+    // Tarjan's stack: visited states of the not yet completed SCCs
+    std::vector<State> S;
+    // explicit DFS stack with the DFS numbers of its states
+    std::vector<frame<Automaton>> frames;
+    std::vector<std::size_t> path;
+
+    auto discover = [&](const State q)
+    {
+        const auto n = low.size();
+        m_numbers.emplace(q, n);
+        low.push_back(n);
+        on_stack.push_back(1);
+        S.push_back(q);
+        frames.emplace_back(q, automat);
+        path.push_back(n);
+    };
+
+    discover(Automaton::INITIAL_STATE);
+    while (!frames.empty())
+    {
+        auto& top = frames.back();
+        const auto v = path.back();
+        if (!top.expanded())
+        {
+            const auto r = *top.next++;
+            if (const auto &it = m_numbers.find(r); it == m_numbers.end())
+                /// \note invalidates @top
+                discover(r);
+            else if (on_stack[it->second])
+                low[v] = std::min(low[v], it->second);
+            continue;
+        }
+
+        // all successors are visited
+        const auto q = top.state;
+        frames.pop_back();
+        path.pop_back();
+
+        if (low[v] == v)
+        {
+            // the root completes its SCC: the states above it on the Tarjan's stack
+            const auto c = m_sizes.size();
+            m_marks.resize(m_marks.size() + m_width, 0);
+            const std::span<automates::mask::word> J{ m_marks.data() + c * m_width, m_width };
+            std::size_t size = 0;
+            State s;
+            do {
+                s = S.back();
+                S.pop_back();
+                const auto n = m_numbers.find(s)->second;
+                on_stack[n] = 0;
+                low[n] = c;
+                automates::mask::merge(J, automat.indexes_final_sets(s));
+                ++size;
+            } while (s != q);
+
+            auto&& range = automat.successors(q);
+            m_sizes.push_back(size);
+            m_trivial.push_back(size == 1 && std::find(std::begin(range), std::end(range), q) == std::end(range));
+        }
+        else
+            low[path.back()] = std::min(low[path.back()], low[v]);
+    }
+
+    /// \note the stacks storage is never shrunk
+    return automates::memory::vector_bytes(on_stack) + automates::memory::vector_bytes(S) +
+           automates::memory::vector_bytes(frames) + automates::memory::vector_bytes(path);
+}
+
+template<typename State>
+std::optional<std::size_t> scc_table<State>::component(const State q) const noexcept
+{
+    if (const auto &it = m_numbers.find(q); it != m_numbers.end())
+        return m_components[it->second];
+
+    return std::nullopt;
+}
+
+template<typename State>
+bool scc_table<State>::is_accepting(const std::size_t c, const std::span<const automates::mask::word> required)
+        const noexcept
+{
+    if (m_trivial[c])
+        return false;
+
+    const auto J = marks(c);
+    for (std::size_t i = 0; i < m_width; ++i)
+        if ((J[i] & required[i]) != required[i])
+            return false;
+
+    return true;
+}
+
+template<typename State>
+bool scc_table<State>::is_empty() const noexcept
+{
+    for (std::size_t c = 0; c < components_num(); ++c)
+        if (!m_trivial[c] && automates::mask::is_full(marks(c), m_sets_num))
+            return false;
+
+    return true;
+}
+
+template<typename State>
+bool scc_table<State>::is_empty(const std::vector<std::size_t> &sets) const noexcept
+{
+    std::vector<automates::mask::word> required(m_width, 0);
+    for (const auto i : sets)
+    {
+        assert(i < m_sets_num && "Final set index out of range");
+        required[i / automates::mask::WORD_BITS] |= automates::mask::word{1} << (i % automates::mask::WORD_BITS);
+    }
+
+    for (std::size_t c = 0; c < components_num(); ++c)
+        if (is_accepting(c, required))
+            return false;
+
+    return true;
+}
+
+template<typename State>
+std::size_t scc_table<State>::bytes() const noexcept
+{
+    return automates::memory::hashed_bytes(m_numbers) + automates::memory::vector_bytes(m_components) +
+           automates::memory::vector_bytes(m_sizes) + automates::memory::vector_bytes(m_trivial) +
+           automates::memory::vector_bytes(m_marks);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    const scc_table<State> table(automat, scratch_peak);
+    if (scratch_peak)
+        *scratch_peak += table.bytes();
+
+    return table.is_empty();
+}
+
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    const scc_table<State> table(automat, scratch_peak);
+    if (scratch_peak)
+        *scratch_peak += table.bytes();
+
+    return table.is_empty();
+}
+
+template class scc_table<uint16_t>;
+template class scc_table<uint32_t>;
+template class scc_table<uint64_t>;
+
+template bool is_empty(const automates::basic_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*) noexcept;
+
+} // namespace emptiness_check::dfs::tarjan
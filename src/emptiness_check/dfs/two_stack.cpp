@@ -1,103 +1,523 @@
 #include "dfs/two_stack.hpp"
+#include "dfs/frame.hpp"
 
-#include <stack>
+#include <memory_resource>
+#include <span>
+#include <vector>
 #include <algorithm>
-
-#include <iostream>
+#include <cassert>
 
 namespace emptiness_check::dfs::two_stack
 {
 
 /// \typedef to storing DFS visiting info: <state <V entrance, discovery time>>
-using um = std::unordered_map<automates::buchi::atm_size, std::pair<bool, automates::buchi::atm_size>>;
-/// \typedef to storing set of candidates: <state, final indexes set for the state>
-using si = std::stack<std::pair<automates::buchi::atm_size, automates::buchi::indexes_set>>;
+template<typename State>
+using um = std::pmr::unordered_map<State, std::pair<bool, std::size_t>>;
+/// \typedef packed final indexes set (see automates::mask)
+using marks = std::span<const automates::mask::word>;
 
 /// \namespace Anonymous namespace. Helpers with DFS steps
 namespace
 {
 
-/// \brief DFS search with improvements. Will notify NONEMPTY
-/// \param q: the state in which we are now
-/// \param[in,out] S: DFS state visiting info: <state, <bit whether state in V, state discovery time>>
-/// \param[in,out] C: set of candidates, containing the states for which it is not yet known whether they belong to some
-/// cycle that denotes the set of all indices i ∈ K such that q ∈ Fi for NGA
-/// \param[in,out] V: when a state is discovered (greyed), it is pushed into the stack (so states are always ordered
-/// in V by increasing discovery time); and when a root is blackened, all states of V above it (including the root
-/// itself) are popped. Note: V ⊆ S holds at all times
-/// \param[in,out] t: timestamps for the states
+/// \class Stack of candidates: <state, final indexes set for the state>
+/// \details States and their packed indexes sets are stored in the two flat contiguous arrays. Each set occupies the
+///     same number of words (one for up to 64 final sets), so pushing and merging do not allocate once the arrays
+///     have grown
+/// \param State: state type of the automaton
+template<typename State>
+class candidates
+{
+public:
+    /// \brief Create empty stack
+    /// \param width: words in each packed indexes set. 0 for NBA (sets are not tracked)
+    /// \param resource: memory of the arrays
+    candidates(const std::size_t width, std::pmr::memory_resource *resource) noexcept
+        : m_width(width), m_states(resource), m_marks(resource)
+    {}
+
+    /// \brief Push new candidate
+    /// \param q: automaton state
+    /// \param J: packed indexes set of @width words (ignored for 0 width)
+    void push(const State q, const marks J) noexcept
+    {
+        m_states.push_back(q);
+        m_marks.insert(m_marks.end(), J.begin(), J.begin() + static_cast<std::ptrdiff_t>(m_width));
+    }
+
+    /// \brief Remove the top candidate
+    void pop() noexcept
+    {
+        m_states.pop_back();
+        m_marks.resize(m_marks.size() - m_width);
+    }
+
+    /// \brief State of the top candidate
+    /// \return automaton state
+    [[nodiscard]] State top() const noexcept { return m_states.back(); }
+
+    /// \brief Indexes set of the top candidate
+    /// \return packed indexes set
+    [[nodiscard]] marks top_marks() const noexcept { return { m_marks.data() + m_marks.size() - m_width, m_width }; }
+
+    /// \brief Bytes of the arrays
+    /// \note Storage is never shrunk: peak bytes
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return automates::memory::vector_bytes(m_states) + automates::memory::vector_bytes(m_marks);
+    }
+
+private:
+    /// \brief words in each indexes set
+    std::size_t m_width;
+    /// \brief candidate states
+    std::pmr::vector<State> m_states;
+    /// \brief indexes sets of the candidates one after another
+    std::pmr::vector<automates::mask::word> m_marks;
+};
+
+/// \struct Search state shared by the recursive and the iterative searches
+/// \param Automaton: investigated automaton representation
+template<typename Automaton>
+struct context
+{
+    /// \brief Create empty search state
+    /// \param automat: investigated automaton
+    /// \param resource: memory of the search structures
+    context(const Automaton &automat, std::pmr::memory_resource *resource) noexcept
+        : S(resource), C(automat.is_generalized() ? automat.get_mask_words_num() : 0, resource), V(resource),
+          I(automat.is_generalized() ? automat.get_mask_words_num() : 0, 0, resource)
+    {}
+
+    /// \brief DFS state visiting info: <state, <bit whether state in V, state discovery time>>
+    um<typename Automaton::atm_size> S;
+    /// \brief set of candidates, containing the states for which it is not yet known whether they belong to some
+    /// cycle that denotes the set of all indices i ∈ K such that q ∈ Fi for NGA
+    candidates<typename Automaton::atm_size> C;
+    /// \brief when a state is discovered (greyed), it is pushed into the stack (so states are always ordered
+    /// in V by increasing discovery time); and when a root is blackened, all states of V above it (including the root
+    /// itself) are popped. Note: V ⊆ S holds at all times
+    std::pmr::vector<typename Automaton::atm_size> V;
+    /// \brief timestamps for the states
+    std::size_t t = 0;
+    /// \brief merged indexes set of the cycle. Reused by all merges
+    std::pmr::vector<automates::mask::word> I;
+    /// \brief grey state reached by the transition that closes the accepting cycle (valid after NONEMPTY)
+    typename Automaton::atm_size closing = {};
+};
+
+/// \brief Grey the state: push it into C (with its indexes set for NGA) and V, remember discovery time
+/// \param Automaton: investigated automaton representation
+/// \param q: discovered state
+/// \param[in,out] ctx: search state
+/// \param automat: investigated automat
+template<typename Automaton>
+void discover(const typename Automaton::atm_size q, context<Automaton> &ctx, const Automaton &automat) noexcept
+{
+    ctx.C.push(q, automat.indexes_final_sets(q));
+    ctx.V.push_back(q);
+    ctx.S[q] = { true, ++ctx.t };
+}
+
+/// \brief Edge to the grey state r closes a cycle: merge candidates discovered after r. Will notify NONEMPTY
+/// \param Automaton: investigated automaton representation
+/// \param r: reached grey state (in V)
+/// \param[in,out] ctx: search state
 /// \param automat: investigated automat
 /// \return true if we have to continue investigation
-bool dfs(const automates::buchi::atm_size q, um &S, si &C, std::stack<automates::buchi::atm_size> &V,
-         automates::buchi::atm_size& t, const automates::buchi &automat) noexcept
+template<typename Automaton>
+bool merge_candidates(const typename Automaton::atm_size r, context<Automaton> &ctx, const Automaton &automat) noexcept
 {
+    auto& [S, C, V, t, I, closing] = ctx;
     const bool is_nga = automat.is_generalized();
-    // To not calculate without a reason indexes set
-    C.push({ q, is_nga ? automat.indexes_final_sets(q) : automates::buchi::indexes_set{} });
-    V.push(q);
-    S[q] = { true, ++t };
 
-    if (auto iter = automat.m_trans_table.find(q); iter != automat.m_trans_table.end())
-    {
-        for (const auto &r : iter->second)
-            if (const auto &it_bits = S.find(r); it_bits == S.end())
+    std::fill(I.begin(), I.end(), 0);
+    const auto r_time = S[r].second;
+    typename Automaton::atm_size s;
+    do {
+        s = C.top();
+        if (is_nga)
+        {
+            automates::mask::merge(I, C.top_marks());
+            if (automates::mask::is_full(I, automat.get_final_num_sets()))
             {
-                if (!dfs(r, S, C, V, t, automat))
-                    return false;
+                closing = r;
+                return false; // NONEMPTY NGA
             }
-            else if (it_bits->second.first)
+        }
+        else
+        {
+            /// \note: may add 0 due to the NBA
+            if (automat.is_final(s))
             {
-                automates::buchi::indexes_set I{};
-                automates::buchi::atm_size s;
-                do {
-                    const auto& [s_top, J] = C.top();
-                    s = s_top;
-                    if (is_nga)
-                    {
-                        automates::buchi::indexes_set new_I{};
-                        std::set_union(I.begin(), I.end(), J.begin(), J.end(), std::back_inserter(new_I));
-                        I = new_I;
-                        if (I.size() == automat.get_final_num_sets())
-                            return false; // NONEMPTY NGA
-                    }
-                    else
-                    {
-                        /// \note: may add 0 due to the NBA
-                        if (automat.is_final(s))
-                            return false; // NONEMPTY NBA
-                    }
-
-                    C.pop();
-                } while (S[s].second > S[r].second); // lifetime comparing
-                C.push({ s, I });
+                closing = r;
+                return false; // NONEMPTY NBA
             }
-    }
+        }
+
+        C.pop();
+    } while (S[s].second > r_time); // lifetime comparing
+    C.push(s, I);
+
+    return true;
+}
+
+/// \brief Blacken the state. If it is a root (top candidate), pop its component from C and V
+/// \param Automaton: investigated automaton representation
+/// \param q: fully expanded state
+/// \param[in,out] ctx: search state
+template<typename Automaton>
+void blacken(const typename Automaton::atm_size q, context<Automaton> &ctx) noexcept
+{
+    auto& [S, C, V, t, I, closing] = ctx;
 
-    if (const auto& [c_q, _] = C.top(); c_q == q)
+    if (C.top() == q)
     {
         C.pop();
-        automates::buchi::atm_size s;
+        typename Automaton::atm_size s;
         do {
-            s = V.top();
-            V.pop();
+            s = V.back();
+            V.pop_back();
             S[s].first = false;
         } while (s != q);
     }
 
     ++t;
+}
+
+/// \brief Recursive DFS search with improvements. Will notify NONEMPTY
+/// \note Reference implementation: depth is limited by the call stack
+/// \param Automaton: investigated automaton representation
+/// \param q: the state in which we are now
+/// \param[in,out] ctx: search state
+/// \param automat: investigated automat
+/// \return true if we have to continue investigation
+template<typename Automaton>
+bool dfs_recursive(const typename Automaton::atm_size q, context<Automaton> &ctx, const Automaton &automat) noexcept
+{
+    discover(q, ctx, automat);
+
+    for (const auto &r : automat.successors(q))
+        if (const auto &it_bits = ctx.S.find(r); it_bits == ctx.S.end())
+        {
+            if (!dfs_recursive(r, ctx, automat))
+                return false;
+        }
+        else if (it_bits->second.first)
+        {
+            if (!merge_candidates(r, ctx, automat))
+                return false;
+        }
+
+    blacken(q, ctx);
     return true;
 }
 
+/// \brief Iterative DFS search with improvements. Will notify NONEMPTY
+/// \note Frames are kept on the explicit heap-allocated stack: depth is limited by memory only
+/// \param Automaton: investigated automaton representation
+/// \param Order: successors visiting order
+/// \param q: the state the search starts from
+/// \param[in,out] ctx: search state
+/// \param[in,out] order: successors visiting order
+/// \param[in,out] frames: explicit DFS stack
+/// \param automat: investigated automat
+/// \return true if we have to continue investigation
+template<typename Automaton, typename Order>
+bool dfs(const typename Automaton::atm_size q, context<Automaton> &ctx, Order &order,
+         std::pmr::vector<typename Order::frame_type> &frames, const Automaton &automat) noexcept
+{
+    discover(q, ctx, automat);
+    frames.push_back(order.open(q, automat));
+
+    while (!frames.empty())
+    {
+        auto& top = frames.back();
+        if (!top.expanded())
+        {
+            const auto r = order.next(top);
+            if (const auto &it_bits = ctx.S.find(r); it_bits == ctx.S.end())
+            {
+                discover(r, ctx, automat);
+                /// \note invalidates @top
+                frames.push_back(order.open(r, automat));
+            }
+            else if (it_bits->second.first)
+            {
+                if (!merge_candidates(r, ctx, automat))
+                    return false;
+            }
+            continue;
+        }
+
+        // all successors are visited
+        const auto s = top.state;
+        order.close(top);
+        frames.pop_back();
+        blacken(s, ctx);
+    }
+
+    return true;
+}
+
+/// \brief Scratch bytes of the search state
+/// \note S only grows, the stacks storage is never shrunk
+/// \param Automaton: investigated automaton representation
+/// \param ctx: finished search state
+/// \return peak bytes of @ctx.S, @ctx.C, @ctx.V and @ctx.I
+template<typename Automaton>
+std::size_t scratch_bytes(const context<Automaton> &ctx) noexcept
+{
+    return automates::memory::hashed_bytes(ctx.S) + ctx.C.bytes() +
+           automates::memory::vector_bytes(ctx.V) + automates::memory::vector_bytes(ctx.I);
+}
+
+/// \brief Append the shortest path between the live states (BFS restricted to V)
+/// \param Automaton: investigated automaton representation
+/// \param from: the path source (not appended)
+/// \param to: the path target (appended last)
+/// \param ctx: search state
+/// \param automat: investigated automat
+/// \param[out] out: states of the path
+template<typename Automaton>
+void connect(const typename Automaton::atm_size from, const typename Automaton::atm_size to,
+             const context<Automaton> &ctx, const Automaton &automat,
+             std::vector<typename Automaton::atm_size> &out) noexcept
+{
+    using State = typename Automaton::atm_size;
+    if (from == to)
+        return;
+
+    std::unordered_map<State, State> parent = { { from, from } };
+    std::vector<State> queue = { from };
+    search_order<Automaton> order;
+    for (std::size_t i = 0; i < queue.size() && !parent.contains(to); ++i)
+    {
+        auto f = order.open(queue[i], automat);
+        while (!f.expanded())
+        {
+            const auto r = order.next(f);
+            if (const auto &it = ctx.S.find(r); it != ctx.S.end() && it->second.first &&
+                                                parent.emplace(r, queue[i]).second)
+                queue.push_back(r);
+        }
+        order.close(f);
+    }
+    assert(parent.contains(to) && "Live states of the closed SCC are not connected");
+
+    const auto begin = out.size();
+    for (State s = to; s != from; s = parent[s])
+        out.push_back(s);
+    std::reverse(out.begin() + static_cast<std::ptrdiff_t>(begin), out.end());
+}
+
+/// \brief Rebuild the lasso from the stacks of the interrupted (NONEMPTY) search
+/// \param Automaton: investigated automaton representation
+/// \param Frame: frame of the explicit DFS stack
+/// \param ctx: search state at the moment of NONEMPTY notification
+/// \param frames: DFS stack at the moment of NONEMPTY notification
+/// \param automat: investigated automat
+/// \return found lasso
+template<typename Automaton, typename Frame>
+lasso<typename Automaton::atm_size> extract_lasso(const context<Automaton> &ctx, const std::pmr::vector<Frame> &frames,
+                                                  const Automaton &automat) noexcept
+{
+    using State = typename Automaton::atm_size;
+
+    lasso<State> res;
+    for (const auto& f : frames)
+        res.stem.push_back(f.state);
+    // source of the closing transition starts the cycle
+    const auto q = res.stem.back();
+    res.stem.pop_back();
+
+    // top live states are in the closed SCC: take the ones that add new final sets until all are covered
+    std::vector<automates::mask::word> covered(automat.get_mask_words_num(), 0);
+    std::vector<State> targets;
+    for (auto it = ctx.V.rbegin(); it != ctx.V.rend() &&
+                                   !automates::mask::is_full(covered, automat.get_final_num_sets()); ++it)
+    {
+        const auto J = automat.indexes_final_sets(*it);
+        bool adds = false;
+        for (std::size_t i = 0; i < covered.size(); ++i)
+            adds |= (J[i] & ~covered[i]) != 0;
+        if (adds)
+        {
+            automates::mask::merge(covered, J);
+            targets.push_back(*it);
+        }
+    }
+    targets.push_back(q);
+
+    // q -> closing ~> targets... ~> q
+    res.cycle = { q, ctx.closing };
+    auto from = ctx.closing;
+    for (const auto target : targets)
+    {
+        connect(from, target, ctx, automat, res.cycle);
+        from = target;
+    }
+    // the walk returns to q: the cycle is closed by the transition to the first state
+    res.cycle.pop_back();
+    if (res.cycle.size() > 1 && ctx.closing == q)
+        res.cycle.erase(res.cycle.begin());
+
+    return res;
+}
+
+/// \brief Two-stack entry point that returns the lasso found
+/// \param Automaton: investigated automaton representation
+/// \param automat: investigated automaton
+/// \return the first lasso or nullopt for the empty automaton
+template<typename Automaton>
+std::optional<lasso<typename Automaton::atm_size>> run_lasso(const Automaton &automat) noexcept
+{
+    context<Automaton> ctx(automat, std::pmr::get_default_resource());
+    search_order<Automaton> order;
+    std::pmr::vector<typename search_order<Automaton>::frame_type> frames;
+
+    if (dfs(Automaton::INITIAL_STATE, ctx, order, frames, automat))
+        return std::nullopt;
+
+    return extract_lasso(ctx, frames, automat);
+}
+
+/// \brief Two-stack entry point for any automaton representation
+/// \param Automaton: investigated automaton representation
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search state and frames (if requested)
+/// \param resource: memory of the search state and frames
+/// \return false if it finds at least one (first) lasso
+template<typename Automaton>
+bool run(const Automaton &automat, std::size_t *scratch_peak,
+         std::pmr::memory_resource *resource = std::pmr::get_default_resource()) noexcept
+{
+    context<Automaton> ctx(automat, resource);
+    search_order<Automaton> order;
+    std::pmr::vector<typename search_order<Automaton>::frame_type> frames(resource);
+
+    const bool result = dfs(Automaton::INITIAL_STATE, ctx, order, frames, automat);
+
+    /// \note the frames storage is never shrunk
+    if (scratch_peak)
+        *scratch_peak = scratch_bytes(ctx) + order.bytes() + automates::memory::vector_bytes(frames);
+
+    return result;
+}
+
+/// \brief Recursive two-stack entry point for any automaton representation
+/// \param Automaton: investigated automaton representation
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search state (if requested). Recursion frames are not included
+/// \return false if it finds at least one (first) lasso
+template<typename Automaton>
+bool run_recursive(const Automaton &automat, std::size_t *scratch_peak) noexcept
+{
+    context<Automaton> ctx(automat, std::pmr::get_default_resource());
+
+    const bool result = dfs_recursive(Automaton::INITIAL_STATE, ctx, automat);
+
+    if (scratch_peak)
+        *scratch_peak = scratch_bytes(ctx);
+
+    return result;
+}
+
 } // namespace anonymous
 
-bool is_empty(const automates::buchi &automat) noexcept
+template<typename State>
+bool is_empty(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak) noexcept
 {
-    um S;
-    si C;
-    std::stack<automates::buchi::atm_size> V;
-    automates::buchi::atm_size t = 0;
+    return run(automat, scratch_peak);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run(automat, scratch_peak);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak,
+              std::pmr::memory_resource *scratch) noexcept
+{
+    return run(automat, scratch_peak, scratch);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_implicit_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run(automat, scratch_peak);
+}
+
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_buchi<State> &automat) noexcept
+{
+    return run_lasso(automat);
+}
+
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_frozen_buchi<State> &automat) noexcept
+{
+    return run_lasso(automat);
+}
 
-    return dfs(automates::buchi::INITIAL_STATE, S, C, V, t, automat);
+template<typename State>
+std::optional<lasso<State>> find_lasso(const automates::basic_implicit_buchi<State> &automat) noexcept
+{
+    return run_lasso(automat);
+}
+
+template<typename State>
+bool is_empty_recursive(const automates::basic_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run_recursive(automat, scratch_peak);
 }
 
+template<typename State>
+bool is_empty_recursive(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak) noexcept
+{
+    return run_recursive(automat, scratch_peak);
+}
+
+template bool is_empty(const automates::basic_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*,
+                       std::pmr::memory_resource*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*,
+                       std::pmr::memory_resource*) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*,
+                       std::pmr::memory_resource*) noexcept;
+
+template bool is_empty(const automates::basic_implicit_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_implicit_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty(const automates::basic_implicit_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template std::optional<lasso<uint16_t>> find_lasso(const automates::basic_buchi<uint16_t>&) noexcept;
+template std::optional<lasso<uint32_t>> find_lasso(const automates::basic_buchi<uint32_t>&) noexcept;
+template std::optional<lasso<uint64_t>> find_lasso(const automates::basic_buchi<uint64_t>&) noexcept;
+
+template std::optional<lasso<uint16_t>> find_lasso(const automates::basic_frozen_buchi<uint16_t>&) noexcept;
+template std::optional<lasso<uint32_t>> find_lasso(const automates::basic_frozen_buchi<uint32_t>&) noexcept;
+template std::optional<lasso<uint64_t>> find_lasso(const automates::basic_frozen_buchi<uint64_t>&) noexcept;
+
+template std::optional<lasso<uint16_t>> find_lasso(const automates::basic_implicit_buchi<uint16_t>&) noexcept;
+template std::optional<lasso<uint32_t>> find_lasso(const automates::basic_implicit_buchi<uint32_t>&) noexcept;
+template std::optional<lasso<uint64_t>> find_lasso(const automates::basic_implicit_buchi<uint64_t>&) noexcept;
+
+template bool is_empty_recursive(const automates::basic_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty_recursive(const automates::basic_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty_recursive(const automates::basic_buchi<uint64_t>&, std::size_t*) noexcept;
+
+template bool is_empty_recursive(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*) noexcept;
+template bool is_empty_recursive(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*) noexcept;
+template bool is_empty_recursive(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*) noexcept;
+
 } // namespace emptiness_check::dfs::two_stack
@@ -0,0 +1,73 @@
+#include "parallel/pool.hpp"
+
+#include <algorithm>
+
+namespace emptiness_check::parallel
+{
+
+pool::pool(const unsigned threads) noexcept
+{
+    const unsigned total = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+
+    m_workers.reserve(total - 1);
+    for (unsigned id = 1; id < total; ++id)
+        m_workers.emplace_back(&pool::work, this, id);
+}
+
+pool::~pool() noexcept
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void pool::run(const std::function<void(unsigned)> &task) noexcept
+{
+    if (m_workers.empty())
+    {
+        task(0);
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_task = &task;
+        m_pending = static_cast<unsigned>(m_workers.size());
+        ++m_generation;
+    }
+    m_start.notify_all();
+
+    // the calling thread is the worker 0
+    task(0);
+
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [this] { return !m_pending; });
+}
+
+void pool::work(const unsigned id) noexcept
+{
+    std::size_t seen = 0;
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_start.wait(lock, [this, seen] { return m_stop || m_generation != seen; });
+        if (m_stop)
+            return;
+
+        seen = m_generation;
+        const auto *task = m_task;
+        lock.unlock();
+        (*task)(id);
+        lock.lock();
+
+        if (!--m_pending)
+            m_done.notify_one();
+    }
+}
+
+} // namespace emptiness_check::parallel
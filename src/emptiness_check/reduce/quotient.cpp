@@ -0,0 +1,243 @@
+#include "reduce/quotient.hpp"
+
+#include "parallel/pool.hpp"
+
+#include <algorithm>
+#include <map>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace emptiness_check::reduce
+{
+
+/// \namespace Anonymous namespace. Helpers with the compact graph and the partition refinement
+namespace
+{
+
+/// \brief Number of the states processed by a worker at once
+constexpr std::size_t CHUNK = 1024;
+
+/// \struct Automaton graph over the compact states in CSR form with the acceptance classes
+struct compact_graph
+{
+    /// \brief rows offsets: successors of v are @targets[@offsets[v], @offsets[v + 1])
+    std::vector<std::size_t> offsets = { 0 };
+    /// \brief concatenated successors rows
+    std::vector<std::size_t> targets = {};
+    /// \brief initial partition: the same class for the same final sets indexes
+    std::vector<std::size_t> classes = {};
+
+    /// \brief Number of states
+    [[nodiscard]] std::size_t size() const noexcept { return offsets.size() - 1; }
+};
+
+/// \brief Number the acceptance classes of the states
+/// \param automat: investigated automaton
+/// \param states: original state of each compact one
+/// \return class of each compact state
+template<typename Automaton, typename States>
+std::vector<std::size_t> acceptance_classes(const Automaton &automat, const States &states) noexcept
+{
+    std::map<std::vector<automates::mask::word>, std::size_t> numbers;
+    std::vector<std::size_t> classes;
+    classes.reserve(states.size());
+    for (const auto q : states)
+    {
+        const auto marks = automat.indexes_final_sets(q);
+        const auto &[it, _] = numbers.try_emplace({ marks.begin(), marks.end() }, numbers.size());
+        classes.push_back(it->second);
+    }
+
+    return classes;
+}
+
+/// \brief Hash of the signature
+/// \param signature: block and the sorted successors blocks
+/// \return hash value
+std::size_t signature_hash(const std::span<const std::size_t> signature) noexcept
+{
+    std::size_t seed = signature.size();
+    for (const auto b : signature)
+        seed ^= std::hash<std::size_t>{}(b) + 0x9e3779b9 + (seed << 6u) + (seed >> 2u);
+
+    return seed;
+}
+
+/// \brief Refine the acceptance classes into the coarsest bisimulation
+/// \param graph: compact graph
+/// \param workers: thread pool
+/// \return block of each compact state. Blocks are numbered in the states order (state 0 is in block 0)
+std::vector<std::size_t> refine(const compact_graph &graph, parallel::pool &workers) noexcept
+{
+    const auto n = graph.size();
+    std::vector<std::size_t> block = graph.classes, next(n);
+    std::size_t blocks_num = n ? *std::max_element(block.begin(), block.end()) + 1 : 0;
+
+    // the signature of v takes its row length + 1 places starting from @graph.offsets[v] + v
+    std::vector<std::size_t> signatures(graph.targets.size() + n), lengths(n), hashes(n);
+    auto signature = [&](const std::size_t v) -> std::span<const std::size_t>
+    {
+        return { signatures.data() + graph.offsets[v] + v, lengths[v] };
+    };
+
+    while (true)
+    {
+        parallel::for_each_chunk(workers, n, CHUNK,
+            [&](const std::size_t begin, const std::size_t end, unsigned)
+            {
+                for (std::size_t v = begin; v < end; ++v)
+                {
+                    auto *const first = signatures.data() + graph.offsets[v] + v;
+                    auto *last = first;
+                    *last++ = block[v];
+                    for (std::size_t j = graph.offsets[v]; j < graph.offsets[v + 1]; ++j)
+                        *last++ = block[graph.targets[j]];
+                    std::sort(first + 1, last);
+                    lengths[v] = std::unique(first + 1, last) - first;
+                    hashes[v] = signature_hash(signature(v));
+                }
+            });
+
+        // equal signatures get the same new block: compare with the first state of each candidate block
+        std::unordered_map<std::size_t, std::vector<std::size_t>> candidates;
+        std::vector<std::size_t> representatives;
+        for (std::size_t v = 0; v < n; ++v)
+        {
+            auto &same_hash = candidates[hashes[v]];
+            const auto sig = signature(v);
+            const auto found = std::find_if(same_hash.begin(), same_hash.end(), [&](const std::size_t b)
+            {
+                const auto other = signature(representatives[b]);
+                return std::equal(sig.begin(), sig.end(), other.begin(), other.end());
+            });
+
+            if (found != same_hash.end())
+                next[v] = *found;
+            else
+            {
+                next[v] = representatives.size();
+                same_hash.push_back(next[v]);
+                representatives.push_back(v);
+            }
+        }
+
+        std::swap(block, next);
+        // blocks only split: the same number means the stable partition
+        if (representatives.size() == blocks_num)
+            break;
+        blocks_num = representatives.size();
+    }
+
+    return block;
+}
+
+} // namespace anonymous
+
+template<typename State>
+automates::basic_buchi<State> quotient(const automates::basic_buchi<State> &automat, const unsigned threads) noexcept
+{
+    using automaton = automates::basic_buchi<State>;
+
+    // sorted unique original states. Index is a compact state (the initial one is the smallest: 0)
+    std::vector<State> states = { automaton::INITIAL_STATE };
+    for (const auto& set : automat.get_final_states())
+        states.insert(states.end(), set.begin(), set.end());
+    for (const auto& [from, set] : automat.m_trans_table)
+    {
+        states.push_back(from);
+        states.insert(states.end(), set.begin(), set.end());
+    }
+    std::sort(states.begin(), states.end());
+    states.erase(std::unique(states.begin(), states.end()), states.end());
+    auto compact = [&states](const State q)
+    {
+        return static_cast<std::size_t>(std::lower_bound(states.begin(), states.end(), q) - states.begin());
+    };
+
+    compact_graph graph;
+    graph.offsets.reserve(states.size() + 1);
+    for (const auto q : states)
+    {
+        for (const auto s : automat.successors(q))
+            graph.targets.push_back(compact(s));
+        graph.offsets.push_back(graph.targets.size());
+    }
+    graph.classes = acceptance_classes(automat, states);
+
+    parallel::pool workers(threads);
+    const auto block = refine(graph, workers);
+
+    // result is constructed in the same way as the source automaton
+    auto arena = automates::make_arena(automat.get_construction());
+    typename automaton::table_container delta(automates::resource_of(arena));
+    typename automaton::finals_container finals(automat.get_final_num_sets());
+    for (std::size_t v = 0; v < graph.size(); ++v)
+    {
+        for (std::size_t j = graph.offsets[v]; j < graph.offsets[v + 1]; ++j)
+            delta[static_cast<State>(block[v])].insert(static_cast<State>(block[graph.targets[j]]));
+        for (std::size_t i = 0; i < finals.size(); ++i)
+            if (automat.is_final(states[v], i))
+                finals[i].insert(static_cast<State>(block[v]));
+    }
+
+    return automaton(std::move(finals), std::move(delta), std::move(arena));
+}
+
+template<typename State>
+automates::basic_frozen_buchi<State> quotient(const automates::basic_frozen_buchi<State> &automat,
+                                              const unsigned threads) noexcept
+{
+    using automaton = automates::basic_frozen_buchi<State>;
+
+    // states are dense: the rows and the final states above them
+    std::size_t n = automat.get_states_bound();
+    for (const auto& set : automat.get_final_states())
+        for (const auto f : set)
+            n = std::max<std::size_t>(n, static_cast<std::size_t>(f) + 1);
+
+    compact_graph graph;
+    graph.offsets.reserve(n + 1);
+    graph.targets.reserve(automat.get_edges_num());
+    for (std::size_t q = 0; q < n; ++q)
+    {
+        for (const auto s : automat.successors(static_cast<State>(q)))
+            graph.targets.push_back(s);
+        graph.offsets.push_back(graph.targets.size());
+    }
+    std::vector<State> states(n);
+    for (std::size_t q = 0; q < n; ++q)
+        states[q] = static_cast<State>(q);
+    graph.classes = acceptance_classes(automat, states);
+
+    parallel::pool workers(threads);
+    const auto block = refine(graph, workers);
+
+    typename automaton::edges_container edges;
+    edges.reserve(graph.targets.size());
+    typename automaton::finals_container finals(automat.get_final_num_sets());
+    for (std::size_t v = 0; v < n; ++v)
+    {
+        for (std::size_t j = graph.offsets[v]; j < graph.offsets[v + 1]; ++j)
+            edges.emplace_back(block[v], block[graph.targets[j]]);
+        for (std::size_t i = 0; i < finals.size(); ++i)
+            if (automat.is_final(static_cast<State>(v), i))
+                finals[i].insert(static_cast<State>(block[v]));
+    }
+
+    /// \note duplicates of the merged transitions are removed by the construction
+    return automaton(std::move(finals), std::move(edges));
+}
+
+template automates::basic_buchi<uint16_t> quotient(const automates::basic_buchi<uint16_t>&, unsigned) noexcept;
+template automates::basic_buchi<uint32_t> quotient(const automates::basic_buchi<uint32_t>&, unsigned) noexcept;
+template automates::basic_buchi<uint64_t> quotient(const automates::basic_buchi<uint64_t>&, unsigned) noexcept;
+
+template automates::basic_frozen_buchi<uint16_t> quotient(const automates::basic_frozen_buchi<uint16_t>&,
+                                                          unsigned) noexcept;
+template automates::basic_frozen_buchi<uint32_t> quotient(const automates::basic_frozen_buchi<uint32_t>&,
+                                                          unsigned) noexcept;
+template automates::basic_frozen_buchi<uint64_t> quotient(const automates::basic_frozen_buchi<uint64_t>&,
+                                                          unsigned) noexcept;
+
+} // namespace emptiness_check::reduce
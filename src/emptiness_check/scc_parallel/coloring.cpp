@@ -0,0 +1,378 @@
+#include "scc_parallel/coloring.hpp"
+#include "bfs/dense_graph.hpp"
+
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace emptiness_check::scc_parallel
+{
+
+/// \namespace Anonymous namespace. Helpers with the decomposition rounds
+namespace
+{
+
+/// \brief Number of the items processed by a worker at once
+constexpr std::size_t CHUNK = 1024;
+/// \brief State without the root index / level stamp
+constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+/// \struct Decomposition state shared by the rounds
+struct decomposition
+{
+    /// \brief Create the single class of all states
+    /// \param states_num: number of the dense states
+    /// \param workers_num: number of the workers
+    decomposition(const std::size_t states_num, const unsigned workers_num) noexcept
+        : color(states_num, 0), active(states_num, 1), root(states_num, NONE), label(states_num),
+          stamp(states_num), in_degree(states_num), out_degree(states_num), trimmed(states_num),
+          buffers(workers_num), backward(states_num, workers_num), counts(workers_num, 0)
+    {
+        for (auto& s : stamp)
+            s.store(NONE, std::memory_order_relaxed);
+    }
+
+    /// \brief class of each state
+    std::vector<std::size_t> color;
+    /// \brief states that are not assigned to the SCC yet (non-zero)
+    std::vector<char> active;
+    /// \brief index of the root among the round @sources (for the roots only)
+    std::vector<std::size_t> root;
+    /// \brief maximal state number that reaches the state inside its class (concurrently raised)
+    std::vector<std::atomic<std::size_t>> label;
+    /// \brief last propagation level that queued the state
+    std::vector<std::atomic<std::size_t>> stamp;
+    /// \brief propagation levels of all rounds: numbering continues, so the stamps of the past rounds never match
+    std::size_t level = 0;
+    /// \brief roots of the round
+    std::vector<std::size_t> sources = {};
+    /// \brief number of the active predecessors in the class
+    std::vector<std::atomic<std::size_t>> in_degree;
+    /// \brief number of the active successors in the class
+    std::vector<std::atomic<std::size_t>> out_degree;
+    /// \brief states removed by the current trimming
+    parallel::atomic_bitset trimmed;
+    /// \brief current level of the trimming or the propagation
+    std::vector<std::size_t> frontier = {};
+    /// \brief per-worker output of the level
+    std::vector<std::vector<std::size_t>> buffers;
+    /// \brief backward searches from the roots
+    bfs::direction::engine backward;
+    /// \brief per-worker number of the removed states
+    std::vector<std::size_t> counts;
+
+    /// \brief Bytes of the decomposition
+    /// \note Storage is never shrunk: peak bytes
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return automates::memory::vector_bytes(color) + automates::memory::vector_bytes(active) +
+               automates::memory::vector_bytes(root) + automates::memory::vector_bytes(label) +
+               automates::memory::vector_bytes(stamp) + automates::memory::vector_bytes(sources) +
+               automates::memory::vector_bytes(in_degree) + automates::memory::vector_bytes(out_degree) +
+               trimmed.bytes() + automates::memory::vector_bytes(frontier) + buffers_bytes() +
+               backward.bytes() + automates::memory::vector_bytes(counts);
+    }
+
+    /// \brief Bytes of the per-worker buffers
+    /// \return reserved bytes
+    [[nodiscard]] std::size_t buffers_bytes() const noexcept
+    {
+        std::size_t bytes = automates::memory::vector_bytes(buffers);
+        for (const auto& buffer : buffers)
+            bytes += automates::memory::vector_bytes(buffer);
+
+        return bytes;
+    }
+
+    /// \brief Gather per-worker outputs into the frontier
+    void gather() noexcept
+    {
+        frontier.clear();
+        for (auto& buffer : buffers)
+        {
+            frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+    }
+
+    /// \brief Check if the step stays among the active states of the class
+    /// \param u: step source
+    /// \param v: step target
+    /// \return true if both states are active in the same class
+    [[nodiscard]] bool inside(const std::size_t u, const std::size_t v) const noexcept
+    {
+        return active[v] && color[u] == color[v];
+    }
+
+    /// \brief Sum and reset the per-worker counts
+    /// \return total count
+    std::size_t take_counts() noexcept
+    {
+        const auto total = std::accumulate(counts.begin(), counts.end(), std::size_t{0});
+        std::fill(counts.begin(), counts.end(), 0);
+        return total;
+    }
+};
+
+/// \brief Remove (transitively) states without a predecessor or a successor in their class: they are trivial SCCs
+/// \details Each state counts its active neighbours in the class. Removed states decrement the counters of their
+///     neighbours level by level, so the whole trimming is linear in the class edges
+/// \param State: state type of the automaton
+/// \param graph: dense reachable graph
+/// \param[in,out] dec: decomposition state
+/// \param workers: thread pool
+/// \return number of the removed states
+template<typename State>
+std::size_t trim(const bfs::dense_graph<State> &graph, decomposition &dec, parallel::pool &workers) noexcept
+{
+    auto count = [&dec](const bfs::direction::adjacency &rows, const std::size_t v)
+    {
+        std::size_t num = 0;
+        for (std::size_t j = rows.offsets[v]; j < rows.offsets[v + 1]; ++j)
+            num += dec.inside(v, rows.targets[j]);
+        return num;
+    };
+    // the last removed neighbour puts the state to the next level
+    auto release = [&dec](const bfs::direction::adjacency &rows, std::vector<std::atomic<std::size_t>> &degree,
+                          const std::size_t v, std::vector<std::size_t> &out)
+    {
+        for (std::size_t j = rows.offsets[v]; j < rows.offsets[v + 1]; ++j)
+            if (const auto u = rows.targets[j]; dec.inside(v, u) && degree[u].fetch_sub(1) == 1)
+                out.push_back(u);
+    };
+
+    dec.trimmed.clear();
+    parallel::for_each_chunk(workers, graph.states.size(), CHUNK,
+        [&](const std::size_t begin, const std::size_t end, const unsigned id)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+            {
+                if (!dec.active[v])
+                    continue;
+
+                dec.in_degree[v].store(count(graph.preds, v), std::memory_order_relaxed);
+                dec.out_degree[v].store(count(graph.succs, v), std::memory_order_relaxed);
+                if (!dec.in_degree[v].load(std::memory_order_relaxed) ||
+                    !dec.out_degree[v].load(std::memory_order_relaxed))
+                    dec.buffers[id].push_back(v);
+            }
+        });
+    dec.gather();
+
+    while (!dec.frontier.empty())
+    {
+        parallel::for_each_chunk(workers, dec.frontier.size(), CHUNK,
+            [&](const std::size_t begin, const std::size_t end, const unsigned id)
+            {
+                for (std::size_t f = begin; f < end; ++f)
+                    // the state could be released in both directions
+                    if (const auto v = dec.frontier[f]; dec.trimmed.set(v))
+                    {
+                        ++dec.counts[id];
+                        release(graph.succs, dec.in_degree, v, dec.buffers[id]);
+                        release(graph.preds, dec.out_degree, v, dec.buffers[id]);
+                    }
+            });
+        dec.gather();
+    }
+    const auto removed = dec.take_counts();
+
+    // active states are read by the trimming: remove after
+    if (removed)
+        parallel::for_each_chunk(workers, graph.states.size(), CHUNK,
+            [&dec](const std::size_t begin, const std::size_t end, const unsigned)
+            {
+                for (std::size_t v = begin; v < end; ++v)
+                    if (dec.trimmed.test(v))
+                        dec.active[v] = 0;
+            });
+
+    return removed;
+}
+
+/// \brief Propagate the maximal state numbers forward inside the classes and collect SCCs of the roots
+/// \details After the propagation every state of the SCC of the root (the state that keeps its own number) has the
+///     root number, and the states of that color reaching the root are exactly its SCC
+/// \param State: state type of the automaton
+/// \param graph: dense reachable graph
+/// \param[in,out] dec: decomposition state
+/// \param workers: thread pool
+template<typename State>
+void color_and_search(const bfs::dense_graph<State> &graph, decomposition &dec, parallel::pool &workers) noexcept
+{
+    // every active state starts with its own number and a queued level
+    parallel::for_each_chunk(workers, graph.states.size(), CHUNK,
+        [&dec](const std::size_t begin, const std::size_t end, const unsigned id)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+                if (dec.active[v])
+                {
+                    dec.label[v].store(v, std::memory_order_relaxed);
+                    dec.buffers[id].push_back(v);
+                }
+        });
+    dec.gather();
+
+    // only the raised states are expanded on the next level. The stamp queues them once per level
+    for (; !dec.frontier.empty(); ++dec.level)
+    {
+        const auto level = dec.level;
+        parallel::for_each_chunk(workers, dec.frontier.size(), CHUNK,
+            [&](const std::size_t begin, const std::size_t end, const unsigned id)
+            {
+                for (std::size_t f = begin; f < end; ++f)
+                {
+                    const auto u = dec.frontier[f];
+                    const auto l = dec.label[u].load(std::memory_order_relaxed);
+                    for (std::size_t j = graph.succs.offsets[u]; j < graph.succs.offsets[u + 1]; ++j)
+                    {
+                        const auto v = graph.succs.targets[j];
+                        if (!dec.inside(u, v))
+                            continue;
+
+                        auto current = dec.label[v].load(std::memory_order_relaxed);
+                        while (current < l && !dec.label[v].compare_exchange_weak(current, l,
+                                                                                  std::memory_order_relaxed))
+                        {}
+                        if (current < l && dec.stamp[v].exchange(level, std::memory_order_relaxed) != level)
+                            dec.buffers[id].push_back(v);
+                    }
+                }
+            });
+        dec.gather();
+    }
+
+    // the labels are the new colors: steps of the backward search stay among the states of the root
+    dec.sources.clear();
+    for (std::size_t v = 0; v < graph.states.size(); ++v)
+        if (dec.active[v])
+        {
+            dec.color[v] = dec.label[v].load(std::memory_order_relaxed);
+            if (dec.color[v] == v)
+            {
+                dec.root[v] = dec.sources.size();
+                dec.sources.push_back(v);
+            }
+        }
+
+    dec.backward.run(graph.preds, graph.succs, dec.active, dec.sources, workers, &dec.color);
+}
+
+/// \brief Check the SCCs of the roots for the acceptance and remove them
+/// \param State: state type of the automaton
+/// \param graph: dense reachable graph
+/// \param automat: investigated automaton
+/// \param[in,out] dec: decomposition state
+/// \param workers: thread pool
+/// \param[out] removed: number of the states of the SCCs
+/// \return true if some non-trivial SCC intersects every final set
+template<typename State>
+bool collect(const bfs::dense_graph<State> &graph, const automates::basic_acceptance<State> &automat,
+             decomposition &dec, parallel::pool &workers, std::size_t &removed) noexcept
+{
+    const std::size_t sets_num = automat.get_final_num_sets();
+    // <root, final set> pairs met inside the SCCs of the roots
+    parallel::atomic_bitset accepted(dec.sources.size() * sets_num);
+
+    parallel::for_each_chunk(workers, graph.states.size(), CHUNK,
+        [&](const std::size_t begin, const std::size_t end, const unsigned id)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+            {
+                if (!dec.active[v] || (dec.color[v] != v && !dec.backward.reached(v)))
+                    continue;
+
+                const auto r = dec.root[dec.color[v]];
+                for (std::size_t i = 0; i < sets_num; ++i)
+                    if (automat.is_final(graph.states[v], i))
+                        accepted.set(r * sets_num + i);
+                ++dec.counts[id];
+            }
+        });
+    removed = dec.take_counts();
+
+    // the SCC is non-trivial iff the root reaches itself
+    for (std::size_t r = 0; r < dec.sources.size(); ++r)
+    {
+        if (!dec.backward.reached(dec.sources[r]))
+            continue;
+
+        bool all = true;
+        for (std::size_t i = 0; i < sets_num && all; ++i)
+            all = accepted.test(r * sets_num + i);
+        if (all)
+            return true;
+    }
+
+    // the rest of the colors are the new classes
+    parallel::for_each_chunk(workers, graph.states.size(), CHUNK,
+        [&dec](const std::size_t begin, const std::size_t end, const unsigned)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+                if (dec.active[v] && (dec.color[v] == v || dec.backward.reached(v)))
+                    dec.active[v] = 0;
+        });
+
+    return false;
+}
+
+/// \brief Decomposition rounds over the dense reachable graph (see @is_empty)
+/// \param Automaton: investigated automaton type (with the inverse or the frozen transition table)
+/// \param automat: investigated automaton
+/// \param[out] scratch_peak: peak bytes of the search structures (if requested)
+/// \param threads: number of the worker threads
+/// \return false if it finds at least one (first) accepting SCC
+template<typename Automaton>
+bool run(const Automaton &automat, std::size_t *scratch_peak, const unsigned threads) noexcept
+{
+    std::size_t index_bytes = 0;
+    const auto graph = bfs::build_dense_graph(automat, index_bytes);
+
+    parallel::pool workers(threads);
+    decomposition dec(graph.states.size(), workers.size());
+    std::size_t alive = graph.states.size(), removed = 0;
+    bool accepting = false;
+    while (alive && !accepting)
+    {
+        alive -= trim(graph, dec, workers);
+        if (!alive)
+            break;
+
+        color_and_search(graph, dec, workers);
+        accepting = collect(graph, automat, dec, workers, removed);
+        alive -= removed;
+    }
+
+    if (scratch_peak)
+        *scratch_peak = index_bytes + graph.bytes() + dec.bytes();
+
+    return !accepting;
+}
+
+} // namespace anonymous
+
+template<typename State>
+bool is_empty(const automates::basic_inv_buchi<State> &automat, std::size_t *scratch_peak,
+              const unsigned threads) noexcept
+{
+    return run(automat, scratch_peak, threads);
+}
+
+template<typename State>
+bool is_empty(const automates::basic_frozen_buchi<State> &automat, std::size_t *scratch_peak,
+              const unsigned threads) noexcept
+{
+    return run(automat, scratch_peak, threads);
+}
+
+template bool is_empty(const automates::basic_inv_buchi<uint16_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty(const automates::basic_inv_buchi<uint32_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty(const automates::basic_inv_buchi<uint64_t>&, std::size_t*, unsigned) noexcept;
+
+template bool is_empty(const automates::basic_frozen_buchi<uint16_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint32_t>&, std::size_t*, unsigned) noexcept;
+template bool is_empty(const automates::basic_frozen_buchi<uint64_t>&, std::size_t*, unsigned) noexcept;
+
+} // namespace emptiness_check::scc_parallel
@@ -1,6 +1,8 @@
 #include "statistic.hpp"
 
 #include <vector>
+#include <algorithm>
+#include <memory_resource>
 #include <cassert>
 #include <iostream> // debug purposes
 
@@ -10,17 +12,87 @@ using namespace emptiness_check::statistic;
 namespace
 {
 
+/// \class Memory resource that counts the allocations and passes them to the upstream resource
+/// \note Installed as the default resource for the tracked phases only: the process allocator stays untouched
+class counting_resource final : public std::pmr::memory_resource
+{
+public:
+    /// \brief Wrap the resource
+    /// \param upstream: resource that serves the allocations
+    explicit counting_resource(std::pmr::memory_resource *upstream) noexcept : m_upstream(upstream) {}
+
+    /// \brief Number of the allocations since the construction
+    /// \return allocations number
+    [[nodiscard]] std::size_t allocations() const noexcept { return m_allocations; }
+
+private:
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+        ++m_allocations;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *ptr, const std::size_t bytes, const std::size_t alignment) override
+    {
+        m_upstream->deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    /// \brief resource that serves the allocations
+    std::pmr::memory_resource *m_upstream;
+    /// \brief number of the allocations
+    std::size_t m_allocations = 0;
+};
+
+/// \brief Track allocations of the default memory resource during the function call
+/// \param T: result of the function call
+/// \param counter: counting resource. Must outlive the containers created by @fn
+/// \param fn: callback that will be tracked
+/// \return number of the allocations and the result
+template<typename T>
+std::pair<std::size_t, T> count_call(counting_resource &counter, const std::function<T()> &fn) noexcept
+{
+    const auto start = counter.allocations();
+    auto *previous = std::pmr::set_default_resource(&counter);
+    auto result = fn();
+    std::pmr::set_default_resource(previous);
+
+    return { counter.allocations() - start, std::move(result) };
+}
+
 /// \struct Store statistic for ONE automaton
 struct one_call
 {
     /// \brief Time wasted on generation
     call_durration generation;
+    /// \brief Heap allocations made by generation
+    std::size_t generation_allocs;
+    /// \brief Time wasted on reduction. If this was a case
+    std::optional<call_durration> reduction;
+    /// \brief Footprint of the reduced automaton. If this was a case
+    std::optional<automates::memory_report> reduction_memory;
     /// \brief Time wasted on conversion. If this was a case
     std::optional<call_durration> conversion;
+    /// \brief Heap allocations made by conversion
+    std::size_t conversion_allocs;
+    /// \brief Footprint of the generated automaton
+    automates::memory_report generation_memory;
+    /// \brief Footprint of the converted automaton. If this was a case
+    std::optional<automates::memory_report> conversion_memory;
     /// \brief Time wasted and result of each NBA algorithm
     std::vector<std::pair<call_durration, bool>> nba;
     /// \brief Time wasted and result of each NGA algorithm
     std::vector<std::pair<call_durration, bool>> nga;
+    /// \brief Peak scratch bytes of each NBA algorithm
+    std::vector<std::size_t> nba_scratch;
+    /// \brief Peak scratch bytes of each NGA algorithm
+    std::vector<std::size_t> nga_scratch;
+    /// \brief Edges inspections: <inspected, plain top-down>. If this was a case
+    std::optional<std::pair<std::size_t, std::size_t>> edges;
 };
 
 /// \brief Track time for passed function during its operation
@@ -49,47 +121,113 @@ time_call(std::function<T()> fn) noexcept
 template<typename T>
 one_call calculation(const callbacks_handler<T> &callbacks) noexcept
 {
+    /// \note declared first: the generated and converted containers may keep it as their memory resource
+    counting_resource counter(std::pmr::get_default_resource());
+
     std::cout << "DEBUG: generation..";
     // run generation
-    auto[gen_durr, automaton] = time_call<T>(callbacks.generation_fn);
-    std::cout << "done\nDEBUG: conversion..";
+    auto[gen_allocs, timed_generation] = count_call<std::pair<call_durration, T>>(counter,
+            [&generation_fn = callbacks.generation_fn]() { return time_call<T>(generation_fn); });
+    auto& [gen_durr, automaton] = timed_generation;
+    std::cout << "done\nDEBUG: reduction..";
+    // run reduction (its own phase): the reduced automaton is converted and checked instead of the generated one
+    auto[red_durr, reduced_automaton] = callbacks.reduce_fn ?
+            time_call<std::optional<T>>(
+                [&reduce_fn = callbacks.reduce_fn, &at = automaton]() { return reduce_fn(at); }
+            ) :
+            std::pair<call_durration, std::optional<T>>{ call_durration::zero(), std::nullopt };
+    std::cout << (reduced_automaton ? "done" : "ignored") << "\nDEBUG: conversion..";
+    const T &source = reduced_automaton ? *reduced_automaton : automaton;
     // run conversion
-    auto[conv_durr, nba_automaton] = time_call<std::optional<T>>(
-            [&conv_fn = callbacks.conv_fn, &at = automaton]() { return conv_fn(at); }
-    );
+    auto[conv_allocs, timed_conversion] = count_call<std::pair<call_durration, std::optional<T>>>(counter,
+            [&conv_fn = callbacks.conv_fn, &at = source]()
+            { return time_call<std::optional<T>>([&conv_fn, &at]() { return conv_fn(at); }); });
+    auto& [conv_durr, nba_automaton] = timed_conversion;
     std::cout << (nba_automaton ? "done" : "ignored") << '\n';
     // To prevent copying NBA->NBA
-    auto get_worker = [&automaton = automaton, &opt_nba = nba_automaton]() -> const T &
+    auto get_worker = [&automaton = source, &opt_nba = nba_automaton]() -> const T &
     {
         return opt_nba ? *opt_nba : automaton;
     };
 
     std::vector<std::pair<call_durration, bool>> nba_results{};
+    std::vector<std::size_t> nba_scratch(callbacks.nba_algorithms.size(), 0);
     nba_results.reserve(callbacks.nba_algorithms.size());
     // remember NBA results
-    for (const auto &fn : callbacks.nba_algorithms)
+    for (std::size_t j = 0; j < callbacks.nba_algorithms.size(); ++j)
     {
         std::cout << "DEBUG: another NBA..";
-        nba_results.push_back(time_call<bool>([&fn, &nba = get_worker()]() { return fn(nba); }));
+        nba_results.push_back(time_call<bool>([&fn = callbacks.nba_algorithms[j], &nba = get_worker(),
+                                               scratch = &nba_scratch[j]]() { return fn(nba, scratch); }));
         std::cout << "done\n";
     }
 
     std::vector<std::pair<call_durration, bool>> nga_results{};
+    std::vector<std::size_t> nga_scratch{};
     nga_results.reserve(callbacks.nga_algorithms.size());
     // means @automaton is generalized
     if (nba_automaton)
+    {
+        nga_scratch.assign(callbacks.nga_algorithms.size(), 0);
         // remember NGA results
-        for (const auto &fn : callbacks.nga_algorithms)
+        for (std::size_t j = 0; j < callbacks.nga_algorithms.size(); ++j)
         {
             std::cout << "DEBUG: another NGA..";
-            nga_results.push_back(time_call<bool>([&fn, &nga = automaton]() { return fn(nga); }));
+            nga_results.push_back(time_call<bool>([&fn = callbacks.nga_algorithms[j], &nga = source,
+                                                   scratch = &nga_scratch[j]]() { return fn(nga, scratch); }));
             std::cout << "done\n";
         }
+    }
     else
         std::cout << "DEBUG: NGA ignored\n";
 
-    return {.generation = gen_durr, .conversion = nba_automaton ? std::make_optional(conv_durr) : std::nullopt,
-            .nba = std::move(nba_results), .nga = std::move(nga_results)};
+    std::optional<std::pair<std::size_t, std::size_t>> edges{};
+    // out of the timed calls: the counting search is run once more
+    if (callbacks.edges_fn)
+        edges = callbacks.edges_fn(get_worker());
+
+    return {.generation = gen_durr, .generation_allocs = gen_allocs,
+            .reduction = reduced_automaton ? std::make_optional(red_durr) : std::nullopt,
+            .reduction_memory = reduced_automaton ? std::make_optional(reduced_automaton->memory_usage()) :
+                                                    std::nullopt,
+            .conversion = nba_automaton ? std::make_optional(conv_durr) : std::nullopt,
+            .conversion_allocs = conv_allocs,
+            .generation_memory = automaton.memory_usage(),
+            .conversion_memory = nba_automaton ? std::make_optional(nba_automaton->memory_usage()) : std::nullopt,
+            .nba = std::move(nba_results), .nga = std::move(nga_results),
+            .nba_scratch = std::move(nba_scratch), .nga_scratch = std::move(nga_scratch),
+            .edges = edges};
+}
+
+/// \brief Add up automaton footprints
+/// \param common [out]: accumulated footprint
+/// \param one_run: footprint of the one automaton
+void accumulate(automates::memory_report &common, const automates::memory_report &one_run) noexcept
+{
+    common.transitions += one_run.transitions;
+    common.finals += one_run.finals;
+    common.inverse += one_run.inverse;
+}
+
+/// \brief Average accumulated automaton footprint
+/// \param common [out]: accumulated footprint
+/// \param counter: number of the accumulated footprints
+void average(automates::memory_report &common, const std::size_t counter) noexcept
+{
+    common.transitions /= counter;
+    common.finals /= counter;
+    common.inverse /= counter;
+}
+
+/// \brief Keep maximal scratch bytes for each algorithm
+/// \param common [out]: peaks among all runs
+/// \param one_run: peaks of the one run
+void update_peaks(std::vector<std::size_t> &common, const std::vector<std::size_t> &one_run) noexcept
+{
+    if (common.size() < one_run.size())
+        common.resize(one_run.size(), 0);
+    for (std::size_t j = 0; j < one_run.size(); ++j)
+        common[j] = std::max(common[j], one_run[j]);
 }
 
 /// \brief Check algorithms output. All are assumed to be the same. Otherwise, assert. Store positive answers
@@ -136,7 +274,9 @@ one_step one_step_generation(const automates::buchi::atm_size repetition,
 
     automates::buchi::atm_size nba_calls_counter = 0,
                                nga_calls_counter = 0,
-                               conversions_counter = 0;
+                               conversions_counter = 0,
+                               reductions_counter = 0,
+                               edges_counter = 0;
     for (automates::buchi::atm_size i = 0; i < repetition; ++i)
     {
         // calculation call
@@ -144,11 +284,29 @@ one_step one_step_generation(const automates::buchi::atm_size repetition,
 
         // start gathering info
         result.average_generation += run_result.generation;
+        result.average_generation_allocs += run_result.generation_allocs;
+        accumulate(result.average_generation_memory, run_result.generation_memory);
+        if (run_result.reduction)
+        {
+            ++reductions_counter;
+            result.average_reduction += *run_result.reduction;
+            accumulate(result.average_reduction_memory, *run_result.reduction_memory);
+        }
         if (run_result.conversion)
         {
             ++conversions_counter;
             result.average_conversion += *run_result.conversion;
+            result.average_conversion_allocs += run_result.conversion_allocs;
+            accumulate(result.average_conversion_memory, *run_result.conversion_memory);
+        }
+        if (run_result.edges)
+        {
+            ++edges_counter;
+            result.average_inspected_edges += run_result.edges->first;
+            result.average_top_down_edges += run_result.edges->second;
         }
+        update_peaks(result.peak_nba_scratch, run_result.nba_scratch);
+        update_peaks(result.peak_nga_scratch, run_result.nga_scratch);
 
         // Store counters for example NGA algorithms may not be called at all due to only NBA generation
         if (!run_result.nba.empty())
@@ -165,13 +323,29 @@ one_step one_step_generation(const automates::buchi::atm_size repetition,
 
     // get average from the total
     result.average_generation /= repetition;
+    result.average_generation_allocs /= repetition;
+    average(result.average_generation_memory, repetition);
     for (auto&[_, durr] : result.average_nba)
         durr /= nba_calls_counter;
     for (auto&[_, durr] : result.average_nga)
         durr /= nga_calls_counter;
 
+    if (reductions_counter)
+    {
+        result.average_reduction /= reductions_counter;
+        average(result.average_reduction_memory, reductions_counter);
+    }
+    if (edges_counter)
+    {
+        result.average_inspected_edges /= edges_counter;
+        result.average_top_down_edges /= edges_counter;
+    }
     if (conversions_counter)
+    {
         result.average_conversion /= conversions_counter;
+        result.average_conversion_allocs /= conversions_counter;
+        average(result.average_conversion_memory, conversions_counter);
+    }
 
     return std::move(result);
 }
@@ -190,3 +364,21 @@ one_step emptiness_check::statistic::one_step_generation(const automates::buchi:
 {
     return ::one_step_generation<>(repetition, callbacks);
 }
+
+one_step emptiness_check::statistic::one_step_generation(const automates::buchi::atm_size repetition,
+        const callbacks_handler<automates::frozen_buchi> &callbacks) noexcept
+{
+    return ::one_step_generation<>(repetition, callbacks);
+}
+
+one_step emptiness_check::statistic::one_step_generation(const automates::buchi::atm_size repetition,
+        const callbacks_handler<automates::basic_inv_buchi<uint64_t>> &callbacks) noexcept
+{
+    return ::one_step_generation<>(repetition, callbacks);
+}
+
+one_step emptiness_check::statistic::one_step_generation(const automates::buchi::atm_size repetition,
+        const callbacks_handler<automates::basic_frozen_buchi<uint64_t>> &callbacks) noexcept
+{
+    return ::one_step_generation<>(repetition, callbacks);
+}
@@ -0,0 +1,38 @@
+#include "statistic.hpp"
+#include "utils/generator.hpp"
+
+#include <iostream>
+
+/// \brief Average generation allocations counted by the statistic harness
+/// \param arena: construct the hashed tables in the arena
+/// \return averaged allocations number
+std::size_t generation_allocs(const bool arena) noexcept
+{
+    const utils::generator::generator_opts opts{ .states = 1000, .trees = 2, .sets = 1, .edges = 2, .arena = arena };
+    const emptiness_check::statistic::callbacks_handler<automates::buchi> callbacks{
+        .generation_fn = [&opts] { return utils::generator::generate_automaton(opts); },
+        .conv_fn = [](const automates::buchi &) { return std::optional<automates::buchi>(); }
+    };
+
+    return emptiness_check::statistic::one_step_generation(3, callbacks).average_generation_allocs;
+}
+
+/// \brief Check that the harness counts the heap construction and that the arena construction allocates less
+int main()
+{
+    const auto heap = generation_allocs(false), arena = generation_allocs(true);
+    std::cout << "\nheap allocations: " << heap << ", arena allocations: " << arena << "\n";
+
+    if (!heap)
+    {
+        std::cerr << "Heap construction allocations are not counted\n";
+        return 1;
+    }
+    if (arena >= heap)
+    {
+        std::cerr << "Arena construction does not reduce allocations\n";
+        return 1;
+    }
+
+    return 0;
+}